@@ -0,0 +1,322 @@
+#pragma once
+
+#include "hardware/Motor/MotorGroup.hpp"
+#include "lemlib/Feedforward.hpp"
+#include "lemlib/PID.hpp"
+#include "lemlib/util.hpp"
+#include <tuple>
+#include <utility>
+
+/**
+ * Building blocks for the control loops of motions.
+ *
+ * A motion calculates its errors, then passes each error through a chain of stages: a controller, followed by
+ * limiters. The outputs of the chains are mixed into left and right drivetrain outputs, which are sent to the motors.
+ *
+ * Every stage is a small class with a call operator, and chains are templates over their stages, so the compiler can
+ * inline a whole chain into the loop of the motion. Stages store references to the parameters they use, so changes to
+ * the parameters during a motion (for example, lowering the maximum speed while settling) take effect immediately.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void myMotion(lemlib::PID pid, lemlib::MotorGroup& left, lemlib::MotorGroup& right) {
+ *   Number maxSpeed = 0.8;
+ *   Number slewRate = 2;
+ *   auto chain = lemlib::pipeline::chain(lemlib::pipeline::PIDController(pid), lemlib::pipeline::Clamp(maxSpeed),
+ *                                        lemlib::pipeline::Slew(slewRate));
+ *   lemlib::pipeline::DriveOutput output(left, right);
+ *   while (true) {
+ *     const Number error = calculateError();
+ *     output(chain.update(error, 10_msec), 0);
+ *     pros::delay(10);
+ *   }
+ * }
+ * @endcode
+ */
+namespace lemlib::pipeline {
+/**
+ * @brief Information passed to every stage of a chain
+ */
+struct StageContext {
+        /** the time since the chain was last updated */
+        Time dt;
+        /** the output of the chain the last time it was updated */
+        Number prevOutput;
+};
+
+/**
+ * @brief Stage which runs a PID controller on the input
+ */
+class PIDController {
+    public:
+        PIDController(PID& pid)
+            : m_pid(pid) {}
+
+        Number operator()(Number error, const StageContext& context) { return m_pid.update(error, context.dt); }
+    private:
+        PID& m_pid;
+};
+
+/**
+ * @brief Stage which adds feedforward for a planned velocity and acceleration to the input
+ *
+ * Usually placed right after a PIDController, so the PID controller only has to correct the error left over by the
+ * feedforward.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * Number plannedVelocity = 0;
+ * Number plannedAcceleration = 0;
+ * auto chain = lemlib::pipeline::chain(
+ *     lemlib::pipeline::PIDController(pid),
+ *     lemlib::pipeline::AddFeedforward(feedforward, plannedVelocity, plannedAcceleration));
+ * // every iteration, update plannedVelocity and plannedAcceleration from the motion profile before updating the chain
+ * @endcode
+ */
+class AddFeedforward {
+    public:
+        AddFeedforward(const Feedforward& feedforward, const Number& velocity, const Number& acceleration)
+            : m_feedforward(feedforward),
+              m_velocity(velocity),
+              m_acceleration(acceleration) {}
+
+        Number operator()(Number in, const StageContext&) {
+            return in + m_feedforward.calculate(m_velocity, m_acceleration);
+        }
+    private:
+        const Feedforward& m_feedforward;
+        const Number& m_velocity;
+        const Number& m_acceleration;
+};
+
+/**
+ * @brief Stage which limits the magnitude of the input
+ */
+class Clamp {
+    public:
+        Clamp(const Number& max)
+            : m_max(max) {}
+
+        Number operator()(Number in, const StageContext&) const { return units::clamp(in, -m_max, m_max); }
+    private:
+        const Number& m_max;
+};
+
+/**
+ * @brief Stage which limits how fast the output of the chain can change
+ */
+class Slew {
+    public:
+        Slew(const Number& rate, SlewDirection direction = SlewDirection::ALL)
+            : m_rate(rate),
+              m_direction(direction) {}
+
+        Number operator()(Number in, const StageContext& context) const {
+            return slew(in, context.prevOutput, m_rate, context.dt, m_direction);
+        }
+    private:
+        const Number& m_rate;
+        const SlewDirection m_direction;
+};
+
+/**
+ * @brief Stage which limits how fast the output of the chain can change, and how fast that rate can change
+ *
+ * With a jerk of 0, this is the same as Slew. See SCurveSlew
+ */
+class SCurve {
+    public:
+        SCurve(const Number& rate, const Number& jerk, SlewDirection direction = SlewDirection::ALL)
+            : m_rate(rate),
+              m_jerk(jerk),
+              m_limiter(rate, jerk, direction) {}
+
+        Number operator()(Number in, const StageContext& context) {
+            m_limiter.setLimits(m_rate, m_jerk);
+            return m_limiter.update(in, context.prevOutput, context.dt);
+        }
+    private:
+        const Number& m_rate;
+        const Number& m_jerk;
+        SCurveSlew m_limiter;
+};
+
+/**
+ * @brief Stage which constrains the magnitude of the input between a minimum and a maximum. An input of 0 is not
+ * changed
+ */
+class MinSpeed {
+    public:
+        MinSpeed(const Number& max, const Number& min)
+            : m_max(max),
+              m_min(min) {}
+
+        Number operator()(Number in, const StageContext&) const { return constrainPower(in, m_max, m_min); }
+    private:
+        const Number& m_max;
+        const Number& m_min;
+};
+
+/**
+ * @brief Stage which forces the input to be in the direction of travel, and optionally at least a minimum speed
+ */
+class ForceDirection {
+    public:
+        ForceDirection(const bool& reversed)
+            : m_reversed(reversed),
+              m_min(NO_MIN) {}
+
+        ForceDirection(const bool& reversed, const Number& min)
+            : m_reversed(reversed),
+              m_min(min) {}
+
+        Number operator()(Number in, const StageContext&) const {
+            return m_reversed ? units::min(in, -m_min) : units::max(in, m_min);
+        }
+    private:
+        static constexpr Number NO_MIN = 0;
+        const bool& m_reversed;
+        const Number& m_min;
+};
+
+/**
+ * @brief Stage which runs a function on the input, for limits that are specific to a motion
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // halve the output
+ * lemlib::pipeline::Map halve([](Number in) { return in / 2; });
+ * @endcode
+ */
+template <typename F> class Map {
+    public:
+        Map(F f)
+            : m_f(std::move(f)) {}
+
+        Number operator()(Number in, const StageContext&) { return m_f(in); }
+    private:
+        F m_f;
+};
+
+/**
+ * @brief Stage which skips another stage while a condition is true
+ *
+ * @b Example:
+ * @code {.cpp}
+ * bool settling = false;
+ * // slew, except when settling
+ * lemlib::pipeline::Unless slew(settling, lemlib::pipeline::Slew(slewRate));
+ * @endcode
+ */
+template <typename Stage> class Unless {
+    public:
+        Unless(const bool& condition, Stage stage)
+            : m_condition(condition),
+              m_stage(std::move(stage)) {}
+
+        Number operator()(Number in, const StageContext& context) {
+            return m_condition ? in : m_stage(in, context);
+        }
+    private:
+        const bool& m_condition;
+        Stage m_stage;
+};
+
+/**
+ * @brief A chain of stages, where the output of every stage is the input of the next one
+ */
+template <typename... Stages> class Chain {
+    public:
+        Chain(Stages... stages)
+            : m_stages(std::move(stages)...) {}
+
+        /**
+         * @brief Run every stage of the chain
+         *
+         * @param input the input of the first stage, typically the error
+         * @param dt the time since the chain was last updated
+         *
+         * @return Number the output of the last stage
+         */
+        Number update(Number input, Time dt) {
+            const StageContext context {dt, m_prevOutput};
+            std::apply([&](auto&... stage) { ((input = stage(input, context)), ...); }, m_stages);
+            m_prevOutput = input;
+            return input;
+        }
+
+        /**
+         * @brief Get the output of the chain the last time it was updated
+         *
+         * @return Number the previous output. 0 if the chain has not been updated yet
+         */
+        Number getPrevOutput() const { return m_prevOutput; }
+
+        /**
+         * @brief Reset the previous output of the chain
+         */
+        void reset() { m_prevOutput = 0; }
+    private:
+        std::tuple<Stages...> m_stages;
+        Number m_prevOutput = 0;
+};
+
+/**
+ * @brief Create a chain of stages
+ *
+ * @param stages the stages, in the order they should run
+ *
+ * @return Chain<Stages...> the chain
+ */
+template <typename... Stages> Chain<Stages...> chain(Stages... stages) {
+    return Chain<Stages...>(std::move(stages)...);
+}
+
+/**
+ * @brief Mixer which desaturates the drivetrain outputs, so they never exceed 1
+ */
+struct Desaturate {
+        DriveOutputs operator()(Number lateral, Number angular) const { return desaturate(lateral, angular); }
+};
+
+/**
+ * @brief Mixer which adds the lateral and angular outputs without scaling them
+ */
+struct Unmixed {
+        DriveOutputs operator()(Number lateral, Number angular) const {
+            return {lateral - angular, lateral + angular};
+        }
+};
+
+/**
+ * @brief Mixes lateral and angular outputs, and moves the drivetrain
+ *
+ * The motors are MotorGroups by default, but can be anything with the same move() function, like SimulatedMotors
+ */
+template <typename Mixer = Desaturate, typename Motors = MotorGroup> class DriveOutput {
+    public:
+        DriveOutput(Motors& leftMotors, Motors& rightMotors, Mixer mixer = {})
+            : m_leftMotors(leftMotors),
+              m_rightMotors(rightMotors),
+              m_mixer(std::move(mixer)) {}
+
+        /**
+         * @brief Move the drivetrain
+         *
+         * @param lateral the lateral output
+         * @param angular the angular output. Positive turns counterclockwise
+         *
+         * @return DriveOutputs the outputs sent to the motors
+         */
+        DriveOutputs operator()(Number lateral, Number angular) {
+            const DriveOutputs out = m_mixer(lateral, angular);
+            m_leftMotors.move(out.left);
+            m_rightMotors.move(out.right);
+            return out;
+        }
+    private:
+        Motors& m_leftMotors;
+        Motors& m_rightMotors;
+        Mixer m_mixer;
+};
+} // namespace lemlib::pipeline
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "pros/rtos.hpp"
+#include "units/units.hpp"
+#include <array>
+#include <cstdint>
+#include <functional>
+
+namespace lemlib {
+/**
+ * @class Event
+ *
+ * @brief An event that tasks can subscribe to, which wakes them up when it is published
+ *
+ * Subscribed tasks are woken up by setting the NOTIFY_BIT bit of their notification value. Task notifications are
+ * also used to cancel motions, so a task waiting on an event should check which bits are set when it wakes up.
+ */
+class Event {
+    public:
+        /** the bit set in the notification value of subscribed tasks when the event is published */
+        static constexpr std::uint32_t NOTIFY_BIT = 1u << 31;
+        /** the maximum number of tasks that can be subscribed to an event at the same time */
+        static constexpr std::size_t MAX_SUBSCRIBERS = 8;
+        /**
+         * @brief Construct a new Event
+         *
+         * @b Example:
+         * @code {.cpp}
+         * lemlib::Event event;
+         * @endcode
+         */
+        Event() = default;
+        Event(const Event&) = delete;
+        Event& operator=(const Event&) = delete;
+        /**
+         * @brief Subscribe the current task to the event
+         *
+         * @return true the task has been subscribed, or it was already subscribed
+         * @return false there are too many subscribers
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void myTask() {
+         *   event.subscribe();
+         *   while (true) {
+         *     // wait for the event to be published
+         *     pros::Task::notify_take(true, TIMEOUT_MAX);
+         *     // do stuff
+         *   }
+         * }
+         * @endcode
+         */
+        bool subscribe();
+        /**
+         * @brief Unsubscribe the current task from the event
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void myTask() {
+         *   event.subscribe();
+         *   // do stuff
+         *   event.unsubscribe();
+         * }
+         * @endcode
+         */
+        void unsubscribe();
+        /**
+         * @brief Wake up every subscribed task
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void update() {
+         *   // calculate a new value
+         *   // ...
+         *   // let subscribed tasks know there is a new value
+         *   event.publish();
+         * }
+         * @endcode
+         */
+        void publish();
+        /**
+         * @brief Get how many times the event has been published
+         *
+         * @return std::uint32_t the number of times the event has been published
+         */
+        std::uint32_t getCount();
+    private:
+        pros::Mutex m_mutex;
+        std::array<pros::task_t, MAX_SUBSCRIBERS> m_subscribers {};
+        std::uint32_t m_count = 0;
+};
+
+/**
+ * @brief wait until a condition is met, checking it every time an event is published
+ *
+ * The condition is checked right after the event is published, instead of on a fixed interval, so code waiting on
+ * the condition can run in the same tick the condition becomes true.
+ *
+ * @param condition the condition to wait for
+ * @param event the event to check the condition on. Typically published when the inputs of the condition change
+ * @param timeout the maximum amount of time to wait. Waits forever by default
+ *
+ * @return true the condition has been met
+ * @return false the timeout has been reached, or the current task has been notified by something other than the
+ * event (for example, its motion has been cancelled). The notification is left pending
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void autonomous() {
+ *   // start a motion
+ *   lemlib::motion_handler::move([] { lemlib::moveToPoint({24_in, 24_in}, 2_sec, {}, {}); });
+ *   // start the intake as soon as the robot is past y = 12 inches
+ *   lemlib::waitUntil([] { return odom.getPose().y > 12_in; }, odom.getPoseEvent());
+ *   intake.move(1);
+ * }
+ * @endcode
+ */
+bool waitUntil(std::function<bool(void)> condition, Event& event, Time timeout = Time(INFINITY));
+} // namespace lemlib
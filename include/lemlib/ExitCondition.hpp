@@ -2,12 +2,25 @@
 
 #include "units/units.hpp"
 #include "pros/rtos.hpp"
+#include <array>
+#include <initializer_list>
 #include <optional>
+#include <span>
 #include <vector>
 
 namespace lemlib {
 template <isQuantity Q> class ExitCondition {
     public:
+        /** how many times the range the input must be within before the predicted input is checked */
+        static constexpr double PREDICTION_WINDOW = 3;
+
+        /**
+         * @brief Create an exit condition which is never met
+         *
+         * This constructor exists so exit conditions can be stored in fixed-size arrays
+         */
+        ExitCondition() = default;
+
         /**
          * @brief Create a new exit condition
          *
@@ -23,31 +36,93 @@ template <isQuantity Q> class ExitCondition {
             : m_range(range),
               m_time(time) {}
 
+        /**
+         * @brief Create a new velocity-aware exit condition
+         *
+         * The input is only considered settled when it is within the range, and it is changing slower than maxRate.
+         * This way, the exit condition is not met while the robot is moving through the target, so the time can be a
+         * lot shorter.
+         *
+         * Optionally, the exit condition can also predict where the input will settle. If predictionTime is non-zero,
+         * the robot is assumed to decelerate at a constant rate and stop after predictionTime, which moves the input
+         * by half its current rate times predictionTime. The exit condition is met as soon as that prediction is
+         * within the range, as long as the input is already within PREDICTION_WINDOW times the range, so a fast robot
+         * far from the target can't exit early. predictionTime should be roughly how long it takes the robot to stop.
+         *
+         * @param range how far the input can be from 0 before the timer starts
+         * @param time how long the input must be settled before the exit condition is met
+         * @param maxRate how fast the input can change while being settled
+         * @param predictionTime how far ahead to extrapolate the input. 0 disables prediction, which is the default
+         *
+         * @b Example:
+         * @code {.cpp}
+         * // exit once the error is within 1 inch and changing slower than 2 inches per second for 50 milliseconds
+         * lemlib::ExitCondition<Length> settled(1_in, 50_msec, 2_in / 1_sec);
+         * // also exit as soon as the error is predicted to be within 1 inch in 150 ms
+         * lemlib::ExitCondition<Length> predictive(1_in, 50_msec, 2_in / 1_sec, 150_msec);
+         * @endcode
+         */
+        ExitCondition(Q range, Time time, Divided<Q, Time> maxRate, Time predictionTime = 0_sec)
+            : m_range(range),
+              m_time(time),
+              m_maxRate(maxRate),
+              m_predictionTime(predictionTime) {}
+
         /**
          * @brief Update the exit condition
          *
          * @param input the input to check
+         * @param now the current time. Motions pass the timestamp of the current iteration, so the clock is only read
+         * once per iteration
          * @return true the exit condition has been met
          * @return false the exit condition has not been met
          *
          * @b Example:
          * @code {.cpp}
          * // update the exit condition with the input
-         * if (exitCondition.update(input)) {
+         * if (exitCondition.update(input, from_usec(pros::micros()))) {
          *   // the exit condition has been met
          *   doSomething();
          * }
          */
-        bool update(Q input) {
-            if (m_startTime == std::nullopt) m_startTime = from_msec(pros::millis());
-            const Time currentTime = pros::millis() * msec;
-            if (units::abs(input) >= m_range) m_startTime.reset();
-            else if (m_startTime == -1 * sec) m_startTime = currentTime;
-            else if (currentTime >= m_startTime.value() + m_time) m_done = true;
+        bool update(Q input, Time now) {
+            // estimate how fast the input is changing
+            if (m_prevInput != std::nullopt && now > m_prevTime) m_rate = (input - *m_prevInput) / (now - m_prevTime);
+            m_prevInput = input;
+            m_prevTime = now;
+            // predict where the input will settle, if the robot decelerates to a stop over the prediction time
+            if (m_predictionTime > 0_sec && m_rate != std::nullopt && units::abs(input) < m_range * PREDICTION_WINDOW &&
+                units::abs(input + *m_rate * m_predictionTime / 2) < m_range) {
+                m_done = true;
+            }
+
+            const bool settled = units::abs(input) < m_range &&
+                                 (m_maxRate == Divided<Q, Time>(INFINITY) ||
+                                  (m_rate != std::nullopt && units::abs(*m_rate) < m_maxRate));
+            if (m_startTime == std::nullopt) m_startTime = now;
+            if (!settled) m_startTime.reset();
+            else if (now >= m_startTime.value() + m_time) m_done = true;
 
             return m_done;
         }
 
+        /**
+         * @brief Update the exit condition, using the current time
+         *
+         * @param input the input to check
+         * @return true the exit condition has been met
+         * @return false the exit condition has not been met
+         *
+         * @b Example:
+         * @code {.cpp}
+         * // update the exit condition with the input
+         * if (exitCondition.update(input)) {
+         *   // the exit condition has been met
+         *   doSomething();
+         * }
+         */
+        bool update(Q input) { return update(input, from_usec(pros::micros())); }
+
         /**
          * @brief Resets the exit condition (the timer and the done flag)
          *
@@ -58,68 +133,140 @@ template <isQuantity Q> class ExitCondition {
          */
         void reset() {
             m_startTime.reset();
+            m_prevInput.reset();
+            m_rate.reset();
             m_done = false;
         }
     private:
         std::optional<Time> m_startTime = std::nullopt;
+        std::optional<Q> m_prevInput = std::nullopt;
+        Time m_prevTime = 0_sec;
+        std::optional<Divided<Q, Time>> m_rate = std::nullopt;
         bool m_done = false;
-        Q m_range;
-        Time m_time;
+        Q m_range = Q(0);
+        Time m_time = 0_sec;
+        Divided<Q, Time> m_maxRate = Divided<Q, Time>(INFINITY);
+        Time m_predictionTime = 0_sec;
 };
 
+/**
+ * @brief A group of exit conditions, which is met when any of its exit conditions is met
+ *
+ * The exit conditions are stored inline, so the group never allocates and copying it is as cheap as copying an array.
+ * A group can hold up to MAX_EXIT_CONDITIONS exit conditions.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // exit when the error is within 1 inch for 100 ms, or within 3 inches for 500 ms
+ * lemlib::ExitConditionGroup<Length> exitConditions({{1_in, 100_msec}, {3_in, 500_msec}});
+ * @endcode
+ */
 template <isQuantity Q> class ExitConditionGroup {
     public:
+        /** the maximum number of exit conditions in a group */
+        static constexpr std::size_t MAX_EXIT_CONDITIONS = 4;
+
+        /**
+         * @brief Create a new exit condition group
+         *
+         * @param exitConditions the exit conditions to check. Exit conditions past MAX_EXIT_CONDITIONS are ignored
+         */
+        ExitConditionGroup(std::initializer_list<ExitCondition<Q>> exitConditions) {
+            setExitConditions(exitConditions);
+        }
+
+        /**
+         * @brief Create a new exit condition group
+         *
+         * @param exitConditions the exit conditions to check. Exit conditions past MAX_EXIT_CONDITIONS are ignored
+         */
+        ExitConditionGroup(std::span<const ExitCondition<Q>> exitConditions) { setExitConditions(exitConditions); }
+
         /**
          * @brief Create a new exit condition group
          *
-         * @param exitConditions the exit conditions to check
+         * A std::vector would need 2 conversions to become a group through the std::span constructor, so it has its
+         * own constructor
+         *
+         * @param exitConditions the exit conditions to check. Exit conditions past MAX_EXIT_CONDITIONS are ignored
          */
-        ExitConditionGroup(std::vector<ExitCondition<Q>> exitConditions)
-            : m_exitConditions(exitConditions) {}
+        ExitConditionGroup(const std::vector<ExitCondition<Q>>& exitConditions) {
+            setExitConditions(std::span(exitConditions.data(), exitConditions.size()));
+        }
 
         /**
          * @brief Update the exit condition group
          *
+         * Every exit condition is updated, so their timers stay in sync with the input
+         *
          * @param input the input to check
-         * @return true
-         * @return false
+         * @param now the current time, typically the timestamp of the current iteration of the motion
+         * @return true at least one exit condition has been met
+         * @return false no exit condition has been met
          */
-        bool update(Q input) {
-            for (auto& exitCondition : m_exitConditions) {
-                if (exitCondition.update(input)) return true;
-            }
-            return false;
+        bool update(Q input, Time now) {
+            bool done = false;
+            for (auto& exitCondition : getExitConditions()) done |= exitCondition.update(input, now);
+            return done;
         }
 
+        /**
+         * @brief Update the exit condition group, using the current time
+         *
+         * @param input the input to check
+         * @return true at least one exit condition has been met
+         * @return false no exit condition has been met
+         */
+        bool update(Q input) { return update(input, from_usec(pros::micros())); }
+
         /**
          * @brief Resets the exit condition group
          *
          */
         void reset() {
-            for (auto& exitCondition : m_exitConditions) { exitCondition.reset(); }
+            for (auto& exitCondition : getExitConditions()) { exitCondition.reset(); }
         }
 
         /**
          * @brief Set the exit conditions in the group
          *
-         * @param exitConditions the new list of exit conditions
+         * @param exitConditions the new list of exit conditions. Exit conditions past MAX_EXIT_CONDITIONS are ignored
          */
-        void setExitConditions(std::vector<ExitCondition<Q>> exitConditions) { m_exitConditions = exitConditions; }
+        void setExitConditions(std::span<const ExitCondition<Q>> exitConditions) {
+            m_size = 0;
+            for (const auto& exitCondition : exitConditions) addExitCondition(exitCondition);
+        }
+
+        /**
+         * @brief Set the exit conditions in the group
+         *
+         * @param exitConditions the new list of exit conditions. Exit conditions past MAX_EXIT_CONDITIONS are ignored
+         */
+        void setExitConditions(std::initializer_list<ExitCondition<Q>> exitConditions) {
+            setExitConditions(std::span(exitConditions.begin(), exitConditions.size()));
+        }
 
         /**
          * @brief Get the exit conditions in the group
          *
-         * @return std::vector<ExitCondition> the exit conditions
+         * @return std::span<ExitCondition<Q>> view of the exit conditions. Does not copy them
          */
-        std::vector<ExitCondition<Q>> getExitConditions() { return m_exitConditions; }
+        std::span<ExitCondition<Q>> getExitConditions() { return std::span(m_exitConditions.data(), m_size); }
 
         /**
          * @brief Add an exit condition to the group
          *
          * @param exitCondition the exit condition to add
+         * @return true the exit condition has been added
+         * @return false the group is full
          */
-        void addExitCondition(ExitCondition<Q> exitCondition) { m_exitConditions.push_back(exitCondition); }
+        bool addExitCondition(ExitCondition<Q> exitCondition) {
+            if (m_size == MAX_EXIT_CONDITIONS) return false;
+            m_exitConditions[m_size++] = exitCondition;
+            return true;
+        }
     private:
-        std::vector<ExitCondition<Q>> m_exitConditions;
+        std::array<ExitCondition<Q>, MAX_EXIT_CONDITIONS> m_exitConditions {};
+        std::size_t m_size = 0;
 };
-} // namespace lemlib
\ No newline at end of file
+} // namespace lemlib
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "units/units.hpp"
+
+namespace lemlib {
+/**
+ * @brief Struct to hold feedforward gains.
+ *
+ * @param kS static gain, the output needed to overcome static friction
+ * @param kV velocity gain, the output needed per unit of velocity
+ * @param kA acceleration gain, the output needed per unit of acceleration
+ * @param kG gravity gain, the output needed to hold the mechanism in place. Usually 0 for drivetrains
+ */
+struct FeedforwardGains {
+        Number kS = 0;
+        Number kV = 0;
+        Number kA = 0;
+        Number kG = 0;
+};
+
+/**
+ * @class Feedforward
+ *
+ * @brief Calculates the output needed to move a mechanism at a planned velocity and acceleration
+ *
+ * Unlike PID, feedforward does not depend on the error, so it does not have to wait for the error to build up before
+ * moving the mechanism. It is meant to be combined with a PID controller, which then only has to correct small
+ * errors. Velocity and acceleration can use any units, as long as the gains were tuned with the same units.
+ */
+class Feedforward {
+    public:
+        /**
+         * @brief Constructs a new Feedforward controller
+         *
+         * @param kS static gain
+         * @param kV velocity gain
+         * @param kA acceleration gain
+         * @param kG gravity gain
+         *
+         * @b Example:
+         * @code {.cpp}
+         * // a drivetrain which needs 5% power to start moving, 1.5% power per inch per second, and 0.2% power per
+         * // inch per second squared
+         * lemlib::Feedforward feedforward(0.05, 0.015, 0.002);
+         * @endcode
+         */
+        Feedforward(Number kS = 0, Number kV = 0, Number kA = 0, Number kG = 0);
+        /**
+         * @brief Constructs a new Feedforward controller
+         *
+         * @param gains the gains to use
+         *
+         * @b Example:
+         * @code {.cpp}
+         * lemlib::Feedforward feedforward({.kS = 0.05, .kV = 0.015, .kA = 0.002});
+         * @endcode
+         */
+        Feedforward(const FeedforwardGains& gains);
+        /**
+         * @brief Get the current gains
+         *
+         * @return FeedforwardGains the current gains
+         */
+        FeedforwardGains getGains() const;
+        /**
+         * @brief Set the new gains
+         *
+         * @param gains the new gains
+         */
+        void setGains(FeedforwardGains gains);
+        /**
+         * @brief Calculate the output needed to move at a velocity and acceleration
+         *
+         * output = kS * sgn(velocity) + kV * velocity + kA * acceleration + kG
+         *
+         * @param velocity the planned velocity
+         * @param acceleration the planned acceleration
+         * @return Number the output
+         *
+         * @b Example:
+         * @code {.cpp}
+         * // move at 20 inches per second, while accelerating at 50 inches per second squared
+         * const Number ff = feedforward.calculate(20, 50);
+         * // correct the error with a PID controller
+         * motors.move(ff + pid.update(error));
+         * @endcode
+         */
+        Number calculate(Number velocity, Number acceleration = 0) const;
+    private:
+        FeedforwardGains m_gains;
+};
+} // namespace lemlib
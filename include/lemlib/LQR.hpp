@@ -0,0 +1,100 @@
+#pragma once
+
+#include "units/Pose.hpp"
+#include <array>
+
+namespace lemlib {
+/**
+ * @brief How much error is acceptable in each state and input, used to weigh the LQR cost
+ *
+ * The weights are calculated with Bryson's rule: each state or input is divided by its tolerance before it is
+ * squared, so a state at its tolerance costs as much as an input at its tolerance. Lower state tolerances make the
+ * controller track more aggressively, and lower input tolerances make it gentler.
+ */
+struct LQRTolerances {
+        /** acceptable error along the direction the robot is facing */
+        Length x = 2_in;
+        /** acceptable error perpendicular to the direction the robot is facing */
+        Length y = 2_in;
+        /** acceptable heading error */
+        Angle theta = 5_stDeg;
+        /** acceptable correction to the linear velocity */
+        LinearVelocity linear = 20_inps;
+        /** acceptable correction to the angular velocity */
+        AngularVelocity angular = 180_degps;
+};
+
+/**
+ * @brief Velocities calculated by a state-space controller
+ */
+struct UnicycleOutput {
+        /** the linear velocity of the robot */
+        LinearVelocity linear;
+        /** the angular velocity of the robot. Positive is counterclockwise */
+        AngularVelocity angular;
+};
+
+/**
+ * @class UnicycleLQR
+ *
+ * @brief A linear quadratic regulator which tracks a reference pose and velocity with a differential drive
+ *
+ * The robot is modelled as a unicycle, linearized around the reference linear velocity. Unlike a pair of PID
+ * controllers, the linear and angular outputs are calculated from all 3 errors at once, so for example lateral error
+ * is corrected by turning towards the path.
+ *
+ * The linearized model depends on the linear velocity, so gains are precomputed when the controller is constructed,
+ * for a grid of forward speeds. Every update, the gains are interpolated from the grid and multiplied by the error,
+ * so the cost of an update is small and constant.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // precompute gains for speeds up to 70 inches per second, for a 10 ms loop
+ * lemlib::UnicycleLQR lqr({}, 70_inps, 10_msec);
+ *
+ * // every iteration
+ * const lemlib::UnicycleOutput out = lqr.calculate(pose, referencePose, referenceLinear, referenceAngular);
+ * @endcode
+ */
+class UnicycleLQR {
+    public:
+        /** the number of speeds gains are precomputed for */
+        static constexpr size_t GRID_SIZE = 16;
+        /**
+         * @brief Construct a new Unicycle LQR, and precompute its gains
+         *
+         * @param tolerances acceptable errors, used to weigh the cost
+         * @param maxSpeed the fastest reference speed. Faster references use the gains of the max speed
+         * @param period how often the controller is updated
+         */
+        UnicycleLQR(const LQRTolerances& tolerances = {}, LinearVelocity maxSpeed = 80_inps, Time period = 10_msec);
+        /**
+         * @brief Calculate the velocities needed to track a reference
+         *
+         * @param pose the pose of the robot
+         * @param reference the pose the robot should be at
+         * @param referenceLinear the linear velocity the robot should have. Must not be negative
+         * @param referenceAngular the angular velocity the robot should have
+         * @return UnicycleOutput the velocities the robot should move at
+         */
+        UnicycleOutput calculate(units::Pose pose, units::Pose reference, LinearVelocity referenceLinear,
+                                 AngularVelocity referenceAngular) const;
+    private:
+        /** gains in SI units, mapping x, y and theta errors to linear and angular corrections */
+        using Gain = std::array<std::array<double, 3>, 2>;
+
+        /**
+         * @brief Solve the discrete algebraic Riccati equation for a speed, by iterating it until it converges
+         *
+         * @param speed the linear velocity to linearize the model around, in meters per second
+         * @return Gain the optimal gain
+         */
+        Gain solve(double speed) const;
+
+        std::array<double, 3> m_q;
+        std::array<double, 2> m_r;
+        double m_dt;
+        double m_maxSpeed;
+        std::array<Gain, GRID_SIZE> m_gains;
+};
+} // namespace lemlib
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "lemlib/LQR.hpp"
+#include "units/Pose.hpp"
+#include <array>
+
+namespace lemlib {
+/**
+ * @brief The limits of the drivetrain, enforced by the model predictive controller
+ */
+struct MPCConstraints {
+        /** the fastest the robot can drive forwards */
+        LinearVelocity maxLinear = 60_inps;
+        /** the fastest the robot can drive backwards. 0 to only drive forwards */
+        LinearVelocity maxReverse = 20_inps;
+        /** the fastest the robot can turn */
+        AngularVelocity maxAngular = 360_degps;
+        /** the maximum linear acceleration and deceleration */
+        LinearAcceleration maxLinearAcceleration = 120_inps2;
+        /** the maximum angular acceleration and deceleration */
+        AngularAcceleration maxAngularAcceleration = 1440_degps2;
+};
+
+/**
+ * @brief How much error is acceptable at the end of the horizon, used to weigh the MPC cost
+ *
+ * Like LQRTolerances, each error is divided by its tolerance before it is squared. Errors are measured in the frame of
+ * the target, so a lower lateral tolerance makes the robot line up with the target heading earlier, and a lower
+ * heading tolerance makes it care more about the final heading.
+ */
+struct MPCTolerances {
+        /** acceptable error along the target heading */
+        Length longitudinal = 1_in;
+        /** acceptable error perpendicular to the target heading */
+        Length lateral = 0.5_in;
+        /** acceptable heading error */
+        Angle heading = 5_stDeg;
+        /** acceptable angular velocity, which penalizes unnecessary turning */
+        AngularVelocity angular = 720_degps;
+};
+
+/**
+ * @brief The result of a single MPC solve
+ */
+struct MPCSolution {
+        /** the velocities to command until the next solve */
+        UnicycleOutput output;
+        /** the cost of the planned inputs, lower is better */
+        double cost;
+};
+
+/**
+ * @class PoseMPC
+ *
+ * @brief A model predictive controller which drives a differential drive to a pose
+ *
+ * Every update, the controller plans the linear and angular velocities for the next HORIZON steps by simulating a
+ * unicycle model of the robot, and commands the first planned velocities. The plan is optimized with projected
+ * gradient descent, over the change in velocity each step, which makes the velocity and acceleration constraints
+ * simple bounds. The number of iterations is fixed, so each solve takes the same amount of time, and the previous
+ * plan is reused as the starting point of the next solve, so the plan improves over consecutive updates.
+ *
+ * The solver does not depend on PROS, so it can be benchmarked on a computer with tools/mpc-benchmark.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::PoseMPC mpc;
+ *
+ * // every iteration
+ * const lemlib::MPCSolution solution = mpc.solve(pose, target, commanded);
+ * commanded = solution.output;
+ * @endcode
+ */
+class PoseMPC {
+    public:
+        /** the number of steps the controller plans ahead */
+        static constexpr size_t HORIZON = 20;
+        /**
+         * @brief Construct a new Pose MPC
+         *
+         * @param constraints the limits of the drivetrain
+         * @param tolerances acceptable errors, used to weigh the cost
+         * @param step the length of each step of the plan. The controller plans HORIZON * step ahead
+         * @param iterations how many gradient descent iterations each solve runs. Solve time scales linearly with it
+         */
+        PoseMPC(const MPCConstraints& constraints = {}, const MPCTolerances& tolerances = {}, Time step = 50_msec,
+                int iterations = 40);
+        /**
+         * @brief Plan the inputs to reach a target, and get the first one
+         *
+         * @param pose the pose of the robot
+         * @param target the pose the robot should reach
+         * @param current the velocities the robot was last commanded, which acceleration is limited from
+         * @return MPCSolution the velocities to command, and the cost of the plan
+         */
+        MPCSolution solve(units::Pose pose, units::Pose target, UnicycleOutput current);
+        /**
+         * @brief Forget the previous plan. Should be called before starting a new motion
+         */
+        void reset();
+        /**
+         * @brief Get the limits of the drivetrain the controller was constructed with
+         *
+         * @return const MPCConstraints& the constraints
+         */
+        const MPCConstraints& getConstraints() const;
+    private:
+        /** a pair of linear and angular values, in SI units */
+        using Input = std::array<double, 2>;
+
+        /**
+         * @brief Simulate the plan and calculate its cost and gradient
+         *
+         * @param start the state of the robot relative to the target
+         * @param current the velocities the robot was last commanded
+         * @param deltas the change in velocity each step
+         * @param gradient where to write the gradient of the cost with respect to the deltas
+         * @return double the cost of the plan
+         */
+        double evaluate(const std::array<double, 3>& start, const Input& current,
+                        const std::array<Input, HORIZON>& deltas, std::array<Input, HORIZON>& gradient) const;
+        /**
+         * @brief Calculate the velocities of the plan, respecting the velocity limits
+         *
+         * @param current the velocities the robot was last commanded
+         * @param deltas the change in velocity each step
+         * @param inputs where to write the velocities
+         * @param saturated where to write which limit each velocity reached: 1 for the maximum, -1 for the minimum
+         */
+        void integrate(const Input& current, const std::array<Input, HORIZON>& deltas,
+                       std::array<Input, HORIZON>& inputs, std::array<std::array<int, 2>, HORIZON>& saturated) const;
+
+        MPCConstraints m_constraints;
+        std::array<double, 3> m_q;
+        double m_r;
+        Input m_minInput;
+        Input m_maxInput;
+        Input m_maxDelta;
+        double m_dt;
+        int m_iterations;
+        std::array<Input, HORIZON> m_plan = {};
+};
+} // namespace lemlib
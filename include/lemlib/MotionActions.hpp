@@ -0,0 +1,209 @@
+#pragma once
+
+#include "units/Pose.hpp"
+#include <bitset>
+#include <functional>
+#include <vector>
+
+namespace lemlib {
+/**
+ * @brief The progress of a motion, as estimated by the motion every iteration
+ */
+struct MotionProgress {
+        /** how long the motion has been running for */
+        Time elapsed = 0_sec;
+        /** how far the robot has traveled since the motion started */
+        Length distanceTraveled = 0_in;
+        /** estimated fraction of the motion that has been completed, from 0 to 1 */
+        Number fraction = 0;
+        /** estimated time until the motion is completed, based on the current speed of the robot. May be infinite */
+        Time timeRemaining = Time(INFINITY);
+        /** the current lateral error of the motion. 0 if the motion has no lateral error */
+        Length lateralError = 0_in;
+        /** the current angular error of the motion */
+        Angle angularError = 0_stRad;
+};
+
+/**
+ * @class MotionAction
+ *
+ * @brief A callback which runs once during a motion, on the first iteration its condition is met
+ *
+ * Actions are checked by the motion loop every iteration, so they run with the same timing as the motion, without a
+ * separate task polling the pose. Actions run in the motion task, so they should return quickly.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void autonomous() {
+ *   lemlib::moveToPoint({24_in, 48_in}, 3_sec,
+ *                       {.actions = {
+ *                            // start the intake after driving 20 inches
+ *                            lemlib::MotionAction::atDistance(20_in, [] { intake.move(1); }),
+ *                            // raise the lift 0.3 seconds before the robot reaches the target
+ *                            lemlib::MotionAction::beforeEnd(300_msec, [] { lift.move(1); }),
+ *                        }},
+ *                       {});
+ * }
+ * @endcode
+ */
+class MotionAction {
+    public:
+        /**
+         * @brief Create an action which runs when a custom condition is met
+         *
+         * @param condition function which returns true when the action should run
+         * @param callback the function to run
+         *
+         * @b Example:
+         * @code {.cpp}
+         * // run the callback once the robot is within 5 inches of the target, after driving for at least 1 second
+         * lemlib::MotionAction::when(
+         *     [](const lemlib::MotionProgress& progress) {
+         *       return progress.elapsed > 1_sec && progress.lateralError < 5_in;
+         *     },
+         *     [] { intake.move(1); });
+         * @endcode
+         */
+        static MotionAction when(std::function<bool(const MotionProgress&)> condition,
+                                 std::function<void(void)> callback);
+        /**
+         * @brief Create an action which runs once the robot has traveled a certain distance
+         *
+         * @param distance the distance
+         * @param callback the function to run
+         */
+        static MotionAction atDistance(Length distance, std::function<void(void)> callback);
+        /**
+         * @brief Create an action which runs once a certain fraction of the motion has been completed
+         *
+         * @param fraction the fraction, from 0 to 1. For example, 0.4 runs the action at 40% of the motion
+         * @param callback the function to run
+         */
+        static MotionAction atFraction(Number fraction, std::function<void(void)> callback);
+        /**
+         * @brief Create an action which runs a certain amount of time before the motion is expected to end
+         *
+         * @param time how long before the motion is expected to end
+         * @param callback the function to run
+         */
+        static MotionAction beforeEnd(Time time, std::function<void(void)> callback);
+        /**
+         * @brief Create an action which runs once the angular error is smaller than a threshold
+         *
+         * @param error the threshold
+         * @param callback the function to run
+         */
+        static MotionAction atAngularError(AngleRange error, std::function<void(void)> callback);
+        /**
+         * @brief Create an action which runs after the motion has been running for a certain amount of time
+         *
+         * @param time the time
+         * @param callback the function to run
+         */
+        static MotionAction afterTime(Time time, std::function<void(void)> callback);
+        /**
+         * @brief Run the action if its condition is met. Whether the action has already run is tracked by the motion
+         * running it, see ActionRunner
+         *
+         * @param progress the progress of the motion
+         *
+         * @return true the condition was met, and the action has run
+         * @return false the condition was not met
+         */
+        bool update(const MotionProgress& progress) const;
+    private:
+        MotionAction(std::function<bool(const MotionProgress&)> condition, std::function<void(void)> callback);
+        std::function<bool(const MotionProgress&)> m_condition;
+        std::function<void(void)> m_callback;
+};
+
+/**
+ * @class ActionRunner
+ *
+ * @brief Runs the actions of a single motion, each at most once
+ *
+ * Which actions have run is stored here instead of in the actions, so the same actions can be shared by several
+ * motions, even at the same time. Motions create one when they start. The state is stored inline, so it never
+ * allocates memory.
+ */
+class ActionRunner {
+    public:
+        /** the maximum number of actions a single motion can have. Actions past it never run */
+        static constexpr std::size_t MAX_ACTIONS = 32;
+        /**
+         * @brief Construct a new Action Runner
+         *
+         * @param actions the actions of the motion. Must outlive the runner
+         */
+        ActionRunner(const std::vector<MotionAction>& actions);
+        /**
+         * @brief Run every action whose condition is met, and which has not run yet
+         *
+         * @param progress the progress of the motion
+         */
+        void update(const MotionProgress& progress);
+    private:
+        const std::vector<MotionAction>& m_actions;
+        std::bitset<MAX_ACTIONS> m_done;
+};
+
+/**
+ * @class ProgressTracker
+ *
+ * @brief This class exists to simplify estimating the progress of a motion
+ */
+class ProgressTracker {
+    public:
+        /**
+         * @brief Construct a new Progress Tracker
+         *
+         * @param start the pose of the robot when the motion started
+         */
+        ProgressTracker(units::Pose start);
+        /**
+         * @brief Update the distance traveled and the speed of the robot
+         *
+         * @param pose the current pose of the robot
+         * @param delta the time since the last update
+         */
+        void update(units::Pose pose, Time delta);
+        /**
+         * @brief Get the progress of a motion which moves the robot to a position
+         *
+         * @param remaining the remaining distance to travel
+         * @param lateralError the lateral error of the motion
+         * @param angularError the angular error of the motion
+         *
+         * @return MotionProgress the progress
+         */
+        MotionProgress getLinearProgress(Length remaining, Length lateralError, Angle angularError);
+        /**
+         * @brief Get the progress of a motion which turns the robot
+         *
+         * @param angularError the angular error of the motion
+         *
+         * @return MotionProgress the progress
+         */
+        MotionProgress getAngularProgress(Angle angularError);
+        /**
+         * @brief Get the filtered linear speed of the robot
+         *
+         * @return LinearVelocity the magnitude of the linear speed
+         */
+        LinearVelocity getLinearSpeed() const;
+        /**
+         * @brief Get the filtered angular speed of the robot
+         *
+         * @return AngularVelocity the magnitude of the angular speed
+         */
+        AngularVelocity getAngularSpeed() const;
+    private:
+        units::Pose m_lastPose;
+        Time m_elapsed = 0_sec;
+        Length m_distance = 0_in;
+        Angle m_angleTraveled = 0_stRad;
+        LinearVelocity m_linearSpeed = 0_mps;
+        AngularVelocity m_angularSpeed = 0_radps;
+};
+
+} // namespace lemlib
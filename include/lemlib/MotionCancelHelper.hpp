@@ -1,5 +1,6 @@
 #pragma once
 
+#include "lemlib/Event.hpp"
 #include "units/units.hpp"
 
 namespace lemlib {
@@ -14,6 +15,9 @@ class MotionCancelHelper {
          * @brief Construct a new Motion Cancel Helper object
          *
          * @param period how often to update
+         * @param trigger optional event to iterate on. If set, the motion iterates every time the event is published,
+         * instead of every period. If the event is not published for 2 periods, the motion iterates anyway. If the
+         * event has too many subscribers, an error is logged and the motion iterates every period instead.
          *
          * @b Example:
          * @code {.cpp}
@@ -22,14 +26,29 @@ class MotionCancelHelper {
          *   lemlib::MotionCancelHelper helper(10_msec);
          * }
          * @endcode
+         *
+         * @b Example:
+         * @code {.cpp}
+         * lemlib::Event motionTrigger;
+         *
+         * void myMotion() {
+         *   // construct the cancellation helper, which iterates every time
+         *   // motionTrigger is published
+         *   lemlib::MotionCancelHelper helper(10_msec, &motionTrigger);
+         * }
+         * @endcode
          */
-        MotionCancelHelper(Time period);
+        MotionCancelHelper(Time period, Event* trigger = nullptr);
+        MotionCancelHelper(const MotionCancelHelper&) = delete;
+        MotionCancelHelper& operator=(const MotionCancelHelper&) = delete;
         /**
          * @brief wait a certain amount of time
          *
          * This function will return true normally. However, if the task has been notified
          * (the motion handler requests the motion to end), or if the competition state changes,
          * the task will return false, indicating that the motion should end.
+         * If the task is notified while waiting, this function returns immediately, so the motion
+         * can stop without waiting for the rest of the period.
          *
          * This function is meant to be used within the while loop of a motion function.
          * While waiting, other tasks can execute.
@@ -61,6 +80,9 @@ class MotionCancelHelper {
         /**
          * @brief Get the amount of time between the current iteration and the last iteration
          *
+         * The time is measured in microseconds, so it can be used for derivatives without the jitter of a
+         * millisecond clock
+         *
          * @return Time the time between the current iteration and the last iteration
          *
          * @b Example:
@@ -70,17 +92,110 @@ class MotionCancelHelper {
          *   lemlib::MotionCancelHelper helper(10_msec);
          *
          *   while(helper.wait()) {
-         *     helper.getDelta(); // this will return 10_msec unless there isn't enough CPU time
+         *     helper.getDelta(); // this will return about 10_msec unless there isn't enough CPU time
          *   }
          * }
          * @endcode
          */
         Time getDelta();
+        /**
+         * @brief Get the timestamp of the current iteration
+         *
+         * The clock is read once per iteration, in wait(), so everything in the iteration can use the same timestamp
+         * without reading the clock again.
+         *
+         * @return Time the timestamp of the current iteration
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void myMotion() {
+         *   lemlib::MotionCancelHelper helper(10_msec);
+         *
+         *   while (helper.wait()) {
+         *     // check the exit conditions against the timestamp of this iteration
+         *     if (exitConditions.update(error, helper.getTime())) break;
+         *   }
+         * }
+         * @endcode
+         */
+        Time getTime();
+        /**
+         * @brief Destroy the Motion Cancel Helper object. Unsubscribes from the trigger, if there is one
+         */
+        ~MotionCancelHelper();
     private:
         bool m_firstIteration = true;
         std::uint32_t m_prevTime;
-        Time m_prevPrevTime = 0_msec;
+        std::uint64_t m_timestamp;
+        std::uint64_t m_prevTimestamp;
+        std::uint32_t m_notification = 0;
         const int m_originalCompStatus;
         const Time m_period;
+        Event* m_trigger;
+};
+
+/**
+ * @class SubLoop
+ *
+ * @brief This class exists to run part of a motion loop at a slower rate than the rest of the motion loop
+ *
+ * For example, a motion could calculate its angular output every 5 ms, and its lateral output every 20 ms.
+ */
+class SubLoop {
+    public:
+        /**
+         * @brief Construct a new Sub Loop object
+         *
+         * @param period how often the sub loop should run. If it is shorter than the period of the motion loop, the
+         * sub loop runs every iteration
+         * @param loopPeriod the period of the motion loop the sub loop is in
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void myMotion() {
+         *   // create a sub loop which runs every 20 ms, in a motion loop which runs every 5 ms
+         *   lemlib::SubLoop outerLoop(20_msec, 5_msec);
+         * }
+         * @endcode
+         */
+        SubLoop(Time period, Time loopPeriod);
+        /**
+         * @brief Update the sub loop
+         *
+         * This function should be called once every iteration of the motion loop
+         *
+         * @param delta the time since the last iteration of the motion loop
+         *
+         * @return true the sub loop should run this iteration
+         * @return false the sub loop should not run this iteration
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void myMotion() {
+         *   lemlib::MotionCancelHelper helper(5_msec);
+         *   lemlib::SubLoop outerLoop(20_msec, 5_msec);
+         *
+         *   while (helper.wait()) {
+         *     // runs every 5 ms
+         *     updateInnerLoop(helper.getDelta());
+         *     // runs every 20 ms
+         *     if (outerLoop.update(helper.getDelta())) updateOuterLoop(outerLoop.getDelta());
+         *   }
+         * }
+         * @endcode
+         */
+        bool update(Time delta);
+        /**
+         * @brief Get the amount of time between the last time the sub loop ran and the time it ran before that
+         *
+         * @return Time the time between the last 2 iterations of the sub loop
+         */
+        Time getDelta();
+    private:
+        const Time m_period;
+        const Time m_loopPeriod;
+        Time m_elapsed = 0_sec;
+        Time m_delta = 0_sec;
+        bool m_firstIteration = true;
 };
 } // namespace lemlib
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "hardware/Motor/MotorGroup.hpp"
+#include "lemlib/MotionActions.hpp"
+#include "lemlib/MotionCancelHelper.hpp"
+#include "lemlib/PoseSource.hpp"
+#include "lemlib/Timer.hpp"
+#include "lemlib/VoltageCompensation.hpp"
+
+namespace lemlib {
+/**
+ * @class RobotEnvironment
+ *
+ * @brief Everything a motion needs from the robot: the clock, the pose, and the drivetrain motors
+ *
+ * Motions are written against an environment, so the same control law can run on the robot, or against a model of
+ * the drivetrain (see SimulatedEnvironment) to preview a motion before running it. An environment provides:
+ * - wait(), getDelta() and getTime(), like MotionCancelHelper
+ * - isDone(), which is true once the timeout of the motion has passed
+ * - getPose(), the current pose of the robot
+ * - getLeftMotors() and getRightMotors(), the motors of the drivetrain
+ * - updateActions(), which runs the actions of the motion
+ *
+ * @b Example:
+ * @code {.cpp}
+ * template <typename Environment> void myMotion(Environment& env) {
+ *   while (env.wait() && !env.isDone()) {
+ *     const units::Pose pose = env.getPose();
+ *     // calculate outputs
+ *     // ...
+ *     env.getLeftMotors().move(left);
+ *     env.getRightMotors().move(right);
+ *   }
+ * }
+ *
+ * void myMotion(Time timeout) {
+ *   lemlib::RobotEnvironment env(10_msec, nullptr, timeout, odom, leftMotors, rightMotors);
+ *   myMotion(env);
+ * }
+ * @endcode
+ */
+class RobotEnvironment {
+    public:
+        /**
+         * @brief Construct a new Robot Environment
+         *
+         * @param period how often the motion iterates
+         * @param trigger optional event to iterate on. See MotionCancelHelper
+         * @param timeout the maximum amount of time the motion can run for
+         * @param poseSource the source of the pose of the robot. Copied, so it can be a temporary
+         * @param leftMotors the left motors of the drivetrain
+         * @param rightMotors the right motors of the drivetrain
+         */
+        RobotEnvironment(Time period, Event* trigger, Time timeout, const PoseSource& poseSource,
+                         MotorGroup& leftMotors, MotorGroup& rightMotors);
+        /**
+         * @brief Wait until the next iteration. See MotionCancelHelper::wait()
+         *
+         * @return true the motion should continue
+         * @return false the motion has been cancelled
+         */
+        bool wait();
+        /**
+         * @brief Get the time between the current iteration and the last iteration
+         *
+         * @return Time the time between iterations
+         */
+        Time getDelta();
+        /**
+         * @brief Get the timestamp of the current iteration
+         *
+         * @return Time the timestamp
+         */
+        Time getTime();
+        /**
+         * @brief Check whether the timeout of the motion has passed
+         *
+         * @return true the timeout has passed
+         * @return false the timeout has not passed
+         */
+        bool isDone();
+        /**
+         * @brief Get the current pose of the robot
+         *
+         * @return units::Pose the pose
+         */
+        units::Pose getPose();
+        /**
+         * @brief Get the left motors of the drivetrain
+         *
+         * @return CompensatedMotors& the left motors, compensated for the battery voltage if voltage_compensation is
+         * set
+         */
+        CompensatedMotors& getLeftMotors();
+        /**
+         * @brief Get the right motors of the drivetrain
+         *
+         * @return CompensatedMotors& the right motors, compensated for the battery voltage if voltage_compensation is
+         * set
+         */
+        CompensatedMotors& getRightMotors();
+        /**
+         * @brief Run every action whose condition is met
+         *
+         * @param actions the actions
+         * @param progress the progress of the motion
+         */
+        void updateActions(ActionRunner& actions, const MotionProgress& progress);
+    private:
+        MotionCancelHelper m_helper;
+        Timer m_timer;
+        PoseSource m_poseSource;
+        CompensatedMotors m_leftMotors;
+        CompensatedMotors m_rightMotors;
+};
+} // namespace lemlib
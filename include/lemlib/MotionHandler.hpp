@@ -1,12 +1,75 @@
 #pragma once
 
+#include "lemlib/Event.hpp"
+#include "units/units.hpp"
+#include <cstdint>
 #include <functional>
 
 namespace lemlib::motion_handler {
 /**
- * @brief run a motion algorithm
+ * @brief a motion channel
+ *
+ * Each channel has its own motion queue and its own cancellation, so motions on different channels run
+ * concurrently. For example, a lift profile can run on the LIFT channel while the drivetrain is following a path on
+ * the DRIVE channel. Motions on the same channel run one after another, in the order they were queued.
+ *
+ * All channels are served by the motion handler. Each channel has a single worker task which is created the first
+ * time the channel is used, and it is reused for every motion on that channel, so no task is created per motion.
+ *
+ * Custom channels can be created by using ids that are not used by the predefined channels.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // create a custom channel for the arm
+ * constexpr lemlib::motion_handler::Channel ARM {3};
+ * @endcode
+ */
+struct Channel {
+        /** the id of the channel. Must be less than MAX_CHANNELS */
+        std::uint8_t id;
+
+        constexpr bool operator==(const Channel& other) const = default;
+};
+
+/**
+ * @brief statistics on how long motions take to stop after being cancelled
+ *
+ * The latency is measured from the call to cancel() until the motion function returns, which is after it has braked
+ * the motors.
+ */
+struct CancelStats {
+        /** the latency of the last cancellation */
+        Time lastLatency = 0_sec;
+        /** the highest latency recorded */
+        Time maxLatency = 0_sec;
+        /** how many running motions have been cancelled */
+        std::uint32_t cancellations = 0;
+};
+
+/** the maximum number of channels */
+constexpr std::uint8_t MAX_CHANNELS = 8;
+/** the maximum number of motions that can be queued on a single channel, excluding the running motion */
+constexpr std::uint8_t MAX_QUEUED_MOTIONS = 8;
+
+/** the drivetrain channel. This is the default channel */
+constexpr Channel DRIVE {0};
+/** channel for a lift */
+constexpr Channel LIFT {1};
+/** channel for an intake */
+constexpr Channel INTAKE {2};
+
+/**
+ * @brief queue a motion algorithm
+ *
+ * The motion will start as soon as every motion queued before it on the same channel has finished. This function
+ * returns immediately, unless the queue of the channel is full, in which case it will wait until there is space.
+ *
+ * Since the motion can run long after this function returns, it must not refer to anything which may have changed or
+ * been destroyed by then, like the local variables of the caller or a loop variable. Capture them by value, as
+ * MOVE_CUSTOM does, or only refer to objects which live for the whole program, like global settings.
  *
  * @param f the motion function
+ * @param channel the channel to run the motion on. DRIVE by default
  *
  * @b Example:
  * @code {.cpp}
@@ -25,19 +88,25 @@ namespace lemlib::motion_handler {
  * // runs during the autonomous period
  * void autonomous() {
  *   // pass the motion to the motion handler
- *   lemlib::motion_handler::move([&] { simpleMotion(); });
- *   // "Hello World!" is printed immediately after the motion starts
+ *   lemlib::motion_handler::move([=] { simpleMotion(); });
+ *   // "Hello World!" is printed immediately after the motion is queued
  *   std::cout << "Hello World!" << std::endl;
- *   // but if we try to run another motion while one is still running,
- *   // it will wait until the last one stops running
- *   lemlib::motion_handler::move([&] { simpleMotion(); });
- *   std::cout << "Last motion ended, new motion started!" << std::endl;
+ *   // the next motion on the same channel is queued, and will start
+ *   // once the last one stops running
+ *   lemlib::motion_handler::move([=] { simpleMotion(); });
+ *   // motions on other channels run at the same time as drive motions
+ *   lemlib::motion_handler::move([=] { simpleMotion(); }, lemlib::motion_handler::LIFT);
  * }
  * @endcode
  */
-void move(std::function<void(void)> f);
+void move(std::function<void(void)> f, Channel channel = DRIVE);
 /**
- * @brief cancel the currently running motion, if it exists
+ * @brief check whether a channel is running a motion, or has motions queued
+ *
+ * @param channel the channel to check. DRIVE by default
+ *
+ * @return true the channel is running a motion or has queued motions
+ * @return false the channel is idle
  *
  * @b Example:
  * @code {.cpp}
@@ -56,8 +125,9 @@ void move(std::function<void(void)> f);
  * // runs during the autonomous period
  * void autonomous() {
  *   // pass the motion to the motion handler
- *   lemlib::motion_handler::move([&] { simpleMotion(); });
+ *   lemlib::motion_handler::move([=] { simpleMotion(); });
  *   lemlib::motion_handler::isMoving(); // returns true
+ *   lemlib::motion_handler::isMoving(lemlib::motion_handler::LIFT); // returns false
  *   // cancel the motion
  *   lemlib::motion_handler::cancel();
  *   pros::delay(10); // give the task time to stop
@@ -65,9 +135,13 @@ void move(std::function<void(void)> f);
  * }
  * @endcode
  */
-bool isMoving();
+bool isMoving(Channel channel = DRIVE);
 /**
- * @brief cancel the currently running motion, if it exists
+ * @brief cancel the currently running motion on a channel, if it exists, and clear the queue of the channel
+ *
+ * Motions on other channels are not affected.
+ *
+ * @param channel the channel to cancel. DRIVE by default
  *
  * @b Example:
  * @code {.cpp}
@@ -87,13 +161,65 @@ bool isMoving();
  * void autonomous() {
  *   // pass the motion to the motion handler
  *   lemlib::motion_handler::move([]{ simpleMotion(); });
+ *   lemlib::motion_handler::move([]{ simpleMotion(); }, lemlib::motion_handler::LIFT);
  *   lemlib::motion_handler::isMoving(); // returns true
- *   // cancel the motion
+ *   // cancel the drive motion
  *   lemlib::motion_handler::cancel();
  *   pros::delay(10); // give the task time to stop
  *   lemlib::motion_handler::isMoving(); // returns false
+ *   lemlib::motion_handler::isMoving(lemlib::motion_handler::LIFT); // returns true
+ * }
+ * @endcode
+ */
+void cancel(Channel channel = DRIVE);
+/**
+ * @brief cancel the running and queued motions on every channel
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void opcontrol() {
+ *   // stop everything the autonomous routine left running
+ *   lemlib::motion_handler::cancelAll();
+ * }
+ * @endcode
+ */
+void cancelAll();
+/**
+ * @brief get the cancel-to-brake latency statistics of a channel
+ *
+ * @param channel the channel. DRIVE by default
+ *
+ * @return CancelStats the statistics
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void opcontrol() {
+ *   // stop the autonomous motion when driver control starts
+ *   lemlib::motion_handler::cancel();
+ *   pros::delay(50);
+ *   const auto stats = lemlib::motion_handler::getCancelStats();
+ *   std::cout << "stopped in " << to_msec(stats.lastLatency) << " ms" << std::endl;
+ * }
+ * @endcode
+ */
+CancelStats getCancelStats(Channel channel = DRIVE);
+/**
+ * @brief get the event which is published every time a motion iterates, and when a motion ends
+ *
+ * This event is published every iteration by motions which use a MotionCancelHelper, which includes every motion in
+ * LemLib. It is also published every time a motion queued with move() ends.
+ *
+ * @return Event& the motion progress event
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void autonomous() {
+ *   lemlib::motion_handler::move([] { lemlib::turnTo(90_cDeg, 2_sec, {}, {}); });
+ *   // wait until the motion has finished, without polling
+ *   lemlib::waitUntil([] { return !lemlib::motion_handler::isMoving(); },
+ *                     lemlib::motion_handler::getProgressEvent());
  * }
  * @endcode
  */
-void cancel();
-} // namespace lemlib::motion_handler
\ No newline at end of file
+Event& getProgressEvent();
+} // namespace lemlib::motion_handler
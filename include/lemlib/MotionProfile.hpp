@@ -0,0 +1,77 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <array>
+
+namespace lemlib {
+/**
+ * @brief The planned state of a mechanism at a point in a motion profile
+ */
+struct ProfileState {
+        /** how far the mechanism has moved since the start of the profile */
+        Number position = 0;
+        /** the velocity of the mechanism */
+        Number velocity = 0;
+        /** the acceleration of the mechanism */
+        Number acceleration = 0;
+};
+
+/**
+ * @class MotionProfile
+ *
+ * @brief A time-optimal profile which moves a mechanism a distance, starting and ending at rest
+ *
+ * Without a jerk limit, the profile is trapezoidal: it accelerates as fast as possible, cruises at the max velocity,
+ * then decelerates as fast as possible. With a jerk limit, it is an S-curve, which also ramps the acceleration up and
+ * down, so the mechanism does not jolt at the start and end of each phase. If the distance is too short to reach the
+ * max velocity, the profile peaks at the highest velocity it can reach instead.
+ *
+ * Like Feedforward, the profile can use any units, as long as they are consistent and use seconds for time.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // turn 1.57 radians, at up to 6 rad/s and 20 rad/s^2, reaching max acceleration in 0.1 seconds
+ * lemlib::MotionProfile profile(1.57, 6, 20, 200);
+ * const lemlib::ProfileState state = profile.sample(100_msec);
+ * @endcode
+ */
+class MotionProfile {
+    public:
+        /**
+         * @brief Construct a new Motion Profile
+         *
+         * @param distance how far to move. Can be negative
+         * @param maxVelocity the maximum velocity. Must be positive
+         * @param maxAcceleration the maximum acceleration and deceleration. Must be positive
+         * @param maxJerk the maximum jerk. 0 for a trapezoidal profile, which is the default
+         */
+        MotionProfile(Number distance, Number maxVelocity, Number maxAcceleration, Number maxJerk = 0);
+        /**
+         * @brief Get the planned state at a time
+         *
+         * @param time the time since the start of the profile. Clamped to the duration of the profile
+         * @return ProfileState the planned state
+         */
+        ProfileState sample(Time time) const;
+        /**
+         * @brief Get how long the profile takes
+         *
+         * @return Time the duration
+         */
+        Time getDuration() const;
+    private:
+        /** a phase of the profile with constant jerk, in seconds and the units of the profile */
+        struct Segment {
+                double duration = 0;
+                double jerk = 0;
+                double position = 0;
+                double velocity = 0;
+                double acceleration = 0;
+        };
+
+        /** the 7 phases: jerk up, constant acceleration, jerk down, cruise, then the same in reverse */
+        std::array<Segment, 7> m_segments;
+        double m_sign;
+        double m_duration = 0;
+};
+} // namespace lemlib
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "units/units.hpp"
+#include <array>
+#include <initializer_list>
+#include <optional>
 
 namespace lemlib {
 /**
@@ -16,6 +19,80 @@ struct Gains {
         Number kD = 0;
 };
 
+/**
+ * @brief What a gain schedule is indexed by
+ */
+enum class ScheduleVariable {
+    /** the magnitude of the error, every update */
+    ERROR,
+    /** the magnitude of the error on the first update after a reset, which is how far the motion has to go */
+    INITIAL_ERROR,
+    /**
+     * a value passed to PID::schedule(). Motions pass the speed of the robot every iteration: in inches per second to
+     * lateral controllers, and in radians per second to angular controllers
+     */
+    EXTERNAL,
+};
+
+/**
+ * @brief A point of a gain schedule
+ */
+struct GainPoint {
+        /** the value of the scheduling variable */
+        Number input = 0;
+        /** the gains to use at that value */
+        Gains gains = {};
+};
+
+/**
+ * @class GainSchedule
+ *
+ * @brief A lookup table of gains, indexed by a scheduling variable
+ *
+ * Gains between points are linearly interpolated, and gains outside of the table use the closest point. The table is
+ * stored inline and is small, so looking up gains is cheap enough to do every iteration.
+ *
+ * Errors use the same units as the errors passed to the PID controller. Motions use meters for lateral errors, and
+ * radians for angular errors.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // small turns need a higher kP than large turns
+ * lemlib::GainSchedule schedule({{0.2, {6, 0, 40}}, {1.6, {3, 0, 25}}, {3.1, {2, 0, 20}}},
+ *                               lemlib::ScheduleVariable::INITIAL_ERROR);
+ * lemlib::PID pid(schedule);
+ * @endcode
+ */
+class GainSchedule {
+    public:
+        /** the maximum number of points in a schedule */
+        static constexpr size_t MAX_POINTS = 8;
+        /**
+         * @brief Construct a new Gain Schedule
+         *
+         * @param points the points of the schedule, sorted by input. Points past MAX_POINTS are ignored
+         * @param variable what the schedule is indexed by. ScheduleVariable::ERROR by default
+         */
+        GainSchedule(std::initializer_list<GainPoint> points, ScheduleVariable variable = ScheduleVariable::ERROR);
+        /**
+         * @brief Get the gains at a value of the scheduling variable
+         *
+         * @param input the value of the scheduling variable
+         * @return Gains the interpolated gains
+         */
+        Gains interpolate(Number input) const;
+        /**
+         * @brief Get what the schedule is indexed by
+         *
+         * @return ScheduleVariable the scheduling variable
+         */
+        ScheduleVariable getVariable() const;
+    private:
+        std::array<GainPoint, MAX_POINTS> m_points;
+        size_t m_size = 0;
+        ScheduleVariable m_variable;
+};
+
 class PID {
     public:
         /**
@@ -54,6 +131,21 @@ class PID {
          * @endcode
          */
         PID(const Gains& gains, Number windupRange = 0, bool signFlipReset = false);
+        /**
+         * @brief Constructs a new PID controller, which takes its gains from a gain schedule
+         *
+         * @param schedule the gain schedule to use
+         * @param windupRange range at which integral is reset
+         * @param signFlipReset whether to reset integral when error changes sign
+         *
+         * @b Example:
+         * @code {.cpp}
+         * // use higher gains for short drives, and lower gains for long drives
+         * lemlib::PID pid(lemlib::GainSchedule({{0.15, {10, 0, 3}}, {1.2, {5, 0, 2}}},
+         *                                      lemlib::ScheduleVariable::INITIAL_ERROR));
+         * @endcode
+         */
+        PID(const GainSchedule& schedule, Number windupRange = 0, bool signFlipReset = false);
         /**
          * @brief Get the current gains
          *
@@ -81,9 +173,52 @@ class PID {
          * @endcode
          */
         void setGains(Gains gains);
+        /**
+         * @brief Set the gain schedule
+         *
+         * While the PID controller has a gain schedule, the gains are replaced by the gains of the schedule every
+         * update, except for schedules indexed by ScheduleVariable::EXTERNAL, which are only applied by schedule().
+         *
+         * @param schedule the new gain schedule, or std::nullopt to stop scheduling the gains
+         *
+         * @b Example:
+         * @code {.cpp}
+         * pid.setGainSchedule(lemlib::GainSchedule({{0.15, {10, 0, 3}}, {1.2, {5, 0, 2}}}));
+         * @endcode
+         */
+        void setGainSchedule(std::optional<GainSchedule> schedule);
+        /**
+         * @brief Get the gain schedule
+         *
+         * @return const std::optional<GainSchedule>& the gain schedule, or std::nullopt if the gains are not scheduled
+         */
+        const std::optional<GainSchedule>& getGainSchedule();
+        /**
+         * @brief Set the gains from the gain schedule, using the given value of the scheduling variable
+         *
+         * Only applies to schedules indexed by ScheduleVariable::EXTERNAL. Does nothing if there is no gain schedule,
+         * or if the schedule is indexed by something else. Motions call this every iteration with the speed of the
+         * robot, so only call it yourself when running the controller in your own loop.
+         *
+         * The PID controller is not thread safe. Don't call this, or change the gains or the gain schedule, from
+         * another task while a motion is using the controller. Change them between motions instead.
+         *
+         * @param input the value of the scheduling variable
+         *
+         * @b Example:
+         * @code {.cpp}
+         * // schedule the gains by the speed of the robot
+         * pid.schedule(to_inps(speed));
+         * const Number output = pid.update(error);
+         * @endcode
+         */
+        void schedule(Number input);
         /**
          * @brief Updates the PID controller using a given error, and outputs the next control signal.
          *
+         * The time since the last update is measured with the microsecond clock. Loops which already know how much
+         * time has passed should use update(error, dt) instead.
+         *
          * @param error the error from the setpoint. Error is calculated as setpoint - current
          * @return Number the control signal (output)
          *
@@ -100,7 +235,24 @@ class PID {
          */
         Number update(Number error);
         /**
-         * @brief Resets the integral and derivative values of the PID controller.
+         * @brief Updates the PID controller using a given error and time delta, and outputs the next control signal.
+         *
+         * Unlike update(error), this function does not read the clock, so it can be used by loops that already
+         * know how much time has passed, or by simulations which run faster than real time.
+         *
+         * @param error the error from the setpoint. Error is calculated as setpoint - current
+         * @param dt the time since the last update. Ignored on the first update after the controller is reset
+         * @return Number the control signal (output)
+         *
+         * @b Example:
+         * @code {.cpp}
+         * // update the PID controller, which is updated every 10 ms
+         * Number output = pid.update(error, 10_msec);
+         * @endcode
+         */
+        Number update(Number error, Time dt);
+        /**
+         * @brief Resets the integral, derivative, and time delta of the PID controller.
          *
          * @b Example:
          * @code {.cpp}
@@ -160,6 +312,7 @@ class PID {
         Number getWindupRange();
     private:
         Gains m_gains;
+        std::optional<GainSchedule> m_schedule = std::nullopt;
 
         bool m_signFlipReset;
         Number m_windupRange;
@@ -168,5 +321,6 @@ class PID {
         Number m_integral = 0;
 
         std::optional<Time> m_previousTime = std::nullopt;
+        bool m_firstUpdate = true;
 };
 } // namespace lemlib
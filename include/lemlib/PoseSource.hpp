@@ -0,0 +1,109 @@
+#pragma once
+
+#include "units/Pose.hpp"
+#include <concepts>
+#include <memory>
+#include <type_traits>
+
+namespace lemlib {
+/**
+ * @brief Concept for classes which estimate the pose of the robot, like TrackingWheelOdometry
+ */
+template <typename T>
+concept PoseProvider = requires(T& t) {
+    { t.getPose() } -> std::convertible_to<units::Pose>;
+};
+
+/**
+ * @class PoseSource
+ *
+ * @brief A non-owning reference to something that returns the pose of the robot
+ *
+ * Unlike std::function, a PoseSource never allocates memory and is as cheap to copy as a pointer, so motion settings
+ * can be created and copied without touching the heap. It can refer to:
+ * - an object with a getPose() member function, like TrackingWheelOdometry
+ * - a function pointer, or a lambda without captures
+ * - any other callable object, like a lambda with captures or a std::function, as long as it is not a temporary
+ *
+ * Since it does not own what it refers to, whatever it refers to must outlive it.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::TrackingWheelOdometry odom( ... );
+ *
+ * void autonomous() {
+ *   // read the pose straight from the odometry
+ *   lemlib::turnTo(90_cDeg, 2_sec, {}, {.poseGetter = odom});
+ *   // lambdas without captures can be used directly
+ *   lemlib::turnTo(90_cDeg, 2_sec, {}, {.poseGetter = [] { return odom.getPose(); }});
+ *   // lambdas with captures must be stored first
+ *   const Length offset = 1_in;
+ *   const auto offsetPose = [&] {
+ *     units::Pose pose = odom.getPose();
+ *     pose.x += offset;
+ *     return pose;
+ *   };
+ *   lemlib::turnTo(90_cDeg, 2_sec, {}, {.poseGetter = offsetPose});
+ * }
+ * @endcode
+ */
+class PoseSource {
+    public:
+        /**
+         * @brief Refer to an object with a getPose() member function
+         *
+         * @param source the object
+         */
+        template <PoseProvider T> PoseSource(T& source)
+            : m_object(const_cast<void*>(static_cast<const void*>(std::addressof(source)))),
+              m_call([](const PoseSource& self) -> units::Pose { return static_cast<T*>(self.m_object)->getPose(); }) {}
+
+        /**
+         * @brief Refer to a function
+         *
+         * @param function the function
+         */
+        PoseSource(units::Pose (*function)())
+            : m_function(function),
+              m_call([](const PoseSource& self) -> units::Pose { return self.m_function(); }) {}
+
+        /**
+         * @brief Refer to a lambda without captures
+         *
+         * @param f the lambda. It is converted to a function pointer, so it can be a temporary
+         */
+        template <typename F>
+            requires std::is_convertible_v<F, units::Pose (*)()>
+        PoseSource(F&& f)
+            : PoseSource(static_cast<units::Pose (*)()>(f)) {}
+
+        /**
+         * @brief Refer to a callable object
+         *
+         * Other PoseSources are excluded, so copying a PoseSource copies what it refers to instead of referring to the
+         * copied PoseSource
+         *
+         * @param f the callable object. Must outlive the PoseSource
+         */
+        template <typename F>
+            requires(!std::same_as<std::remove_cvref_t<F>, PoseSource> && !PoseProvider<F> &&
+                     !std::is_convertible_v<F&, units::Pose (*)()> && std::is_invocable_r_v<units::Pose, F&>)
+        PoseSource(F& f)
+            : m_object(const_cast<void*>(static_cast<const void*>(std::addressof(f)))),
+              m_call([](const PoseSource& self) -> units::Pose { return (*static_cast<F*>(self.m_object))(); }) {}
+
+        /**
+         * @brief Get the pose of the robot
+         *
+         * @return units::Pose the pose
+         */
+        units::Pose operator()() const { return m_call(*this); }
+    private:
+        union {
+                void* m_object;
+                units::Pose (*m_function)();
+        };
+
+        units::Pose (*m_call)(const PoseSource&);
+};
+} // namespace lemlib
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "lemlib/Event.hpp"
+#include "units/units.hpp"
+#include <functional>
+#include <list>
+#include <optional>
+#include <vector>
+
+namespace lemlib {
+/**
+ * @brief Execution statistics of a scheduled job
+ */
+struct JobStats {
+        /** how long the last execution of the job took */
+        Time lastExecutionTime = 0_sec;
+        /** the longest execution of the job */
+        Time maxExecutionTime = 0_sec;
+        /** the sum of the execution times of the job */
+        Time totalExecutionTime = 0_sec;
+        /** how many times the job has been executed */
+        std::uint32_t executions = 0;
+};
+
+/**
+ * @class Scheduler
+ *
+ * @brief Runs periodic jobs at fixed rates from a single task
+ *
+ * Jobs are ordered rate-monotonically: jobs with a shorter period run first, and jobs with the same period run in the
+ * order they were added. Every job is released at the same phase, so the order in which jobs run within a tick is
+ * always the same.
+ *
+ * To make motions iterate right after the odometry has updated, trigger them with the pose event of the odometry, for
+ * example by setting motion_trigger to &odom.getPoseEvent(). The odometry publishes it at the end of every update,
+ * whatever other jobs the scheduler runs. Without a trigger, motions keep their own period, and are not synchronized
+ * with the scheduler at all.
+ *
+ * Running every periodic job from one task means fewer context switches than giving each job its own task.
+ */
+class Scheduler {
+    public:
+        /**
+         * @brief Construct a new Scheduler
+         *
+         * @param tick the base period of the scheduler. The period of every job must be a multiple of it. 5 ms by
+         * default
+         *
+         * @b Example:
+         * @code {.cpp}
+         * // create a scheduler which ticks every 5 milliseconds
+         * lemlib::Scheduler scheduler(5_msec);
+         * @endcode
+         */
+        Scheduler(Time tick = 5_msec);
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+        /**
+         * @brief Add a periodic job
+         *
+         * Jobs should be added before the scheduler is started, but they can also be added while it is running,
+         * including by other jobs. Jobs run without the scheduler being locked, so they can get statistics too.
+         *
+         * A job which uses the results of another job only runs after it in the same tick if it has the same period
+         * and was added after it, or if it has a longer period. A job with a shorter period always runs first.
+         *
+         * @param job the function to run
+         * @param period how often to run the job. Rounded to the nearest multiple of the tick, with a minimum of 1 tick
+         *
+         * @return int the id of the job, which can be used to get its statistics or remove it
+         *
+         * @b Example:
+         * @code {.cpp}
+         * lemlib::Scheduler scheduler(5_msec);
+         * // wake up motions right after the odometry has updated
+         * lemlib::Event* const motion_trigger = &odom.getPoseEvent();
+         *
+         * void initialize() {
+         *   // run the odometry every 10 ms
+         *   odom.startTask(scheduler, 10_msec);
+         *   // update the lift every 20 ms
+         *   scheduler.addJob([] { updateLift(); }, 20_msec);
+         *   scheduler.start();
+         * }
+         * @endcode
+         */
+        int addJob(std::function<void(void)> job, Time period);
+        /**
+         * @brief Remove a job, so it never runs again
+         *
+         * If the job is running in another task, this waits for it to finish, so anything the job uses can be
+         * destroyed once this returns. A job can remove itself, in which case it finishes its current run.
+         *
+         * @param id the id of the job, returned by addJob
+         *
+         * @return true the job has been removed
+         * @return false the job does not exist
+         *
+         * @b Example:
+         * @code {.cpp}
+         * const int liftJob = scheduler.addJob([] { updateLift(); }, 20_msec);
+         * // ...
+         * scheduler.removeJob(liftJob);
+         * @endcode
+         */
+        bool removeJob(int id);
+        /**
+         * @brief Start the scheduler task
+         *
+         * Nothing happens if the scheduler has already been started
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *   scheduler.addJob([] { updateLift(); }, 20_msec);
+         *   scheduler.start();
+         * }
+         * @endcode
+         */
+        void start();
+        /**
+         * @brief Get the execution statistics of a job
+         *
+         * @param id the id of the job, returned by addJob
+         *
+         * @return std::nullopt the job does not exist
+         * @return JobStats the statistics of the job
+         *
+         * @b Example:
+         * @code {.cpp}
+         * const int liftJob = scheduler.addJob([] { updateLift(); }, 20_msec);
+         * // ...
+         * const auto stats = scheduler.getStats(liftJob);
+         * if (stats) std::cout << to_usec(stats->maxExecutionTime) << std::endl;
+         * @endcode
+         */
+        std::optional<JobStats> getStats(int id);
+        /**
+         * @brief Get the number of ticks where the jobs took longer to run than the tick period
+         *
+         * @return std::uint32_t the number of overrun ticks
+         */
+        std::uint32_t getOverruns();
+        /**
+         * @brief Destroy the Scheduler. Stops the scheduler task, and waits for the jobs running in the current tick
+         * to finish. Must not be called from a job
+         */
+        ~Scheduler();
+    private:
+        struct Job {
+                int id;
+                std::function<void(void)> function;
+                std::uint32_t periodTicks;
+                JobStats stats;
+                bool removed = false;
+        };
+
+        /**
+         * @brief run the jobs. This function should have its own dedicated task
+         */
+        void loop();
+        const std::uint32_t m_tickMsec;
+        std::uint32_t m_overruns = 0;
+        int m_nextId = 0;
+        /** every job, in the order they were added. Removed jobs are only destroyed by the scheduler task, between
+         * ticks, so pointers to them stay valid while they could be running */
+        std::list<Job> m_storage;
+        /** the jobs, in rate monotonic order */
+        std::vector<Job*> m_jobs;
+        /** the jobs which are due in the current tick. Only used by the scheduler task */
+        std::vector<Job*> m_due;
+        /** the job the scheduler task is running, if any */
+        Job* m_running = nullptr;
+        pros::Mutex m_mutex;
+        std::optional<pros::Task> m_task = std::nullopt;
+};
+} // namespace lemlib
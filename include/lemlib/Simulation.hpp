@@ -0,0 +1,179 @@
+#pragma once
+
+#include "hardware/Motor/Motor.hpp"
+#include "lemlib/MotionActions.hpp"
+#include "units/Pose.hpp"
+
+namespace lemlib {
+/**
+ * @brief A simple model of a differential drivetrain
+ *
+ * Each side of the drivetrain accelerates towards its commanded speed like a first order system: it covers about 63%
+ * of the difference between its current speed and its commanded speed every time constant.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // a drivetrain with a top speed of 70 inches per second, which reaches 63% of its top speed in 120 ms
+ * lemlib::DrivetrainModel model {.maxSpeed = 70_inps, .timeConstant = 120_msec, .trackWidth = 11_in};
+ * @endcode
+ */
+struct DrivetrainModel {
+        /** the speed of each side of the drivetrain at full power */
+        LinearVelocity maxSpeed = 60_inps;
+        /** how quickly each side of the drivetrain reaches its commanded speed */
+        Time timeConstant = 100_msec;
+        /** the distance between the left and right wheels */
+        Length trackWidth = 12_in;
+        /** the diameter of the wheels */
+        Length wheelDiameter = 3.25_in;
+};
+
+/**
+ * @brief The predicted result of a motion
+ */
+struct MotionPreview {
+        /** how long the motion is predicted to run for */
+        Time duration = 0_sec;
+        /** the predicted pose of the robot once it has stopped after the motion */
+        units::Pose finalPose = {0_in, 0_in, 0_stRad};
+        /** the largest power commanded to the left side of the drivetrain, from 0 to 1 */
+        Number peakLeftOutput = 0;
+        /** the largest power commanded to the right side of the drivetrain, from 0 to 1 */
+        Number peakRightOutput = 0;
+        /** whether the motion is predicted to end because of its timeout */
+        bool timedOut = false;
+};
+
+/**
+ * @class SimulatedMotors
+ *
+ * @brief One side of a simulated drivetrain. Has the same interface as MotorGroup, as far as motions are concerned
+ */
+class SimulatedMotors {
+    public:
+        /**
+         * @brief Construct a new Simulated Motors object
+         *
+         * @param model the model of the drivetrain
+         */
+        SimulatedMotors(const DrivetrainModel& model);
+        /**
+         * @brief Command the motors
+         *
+         * @param percent the power, from -1 to 1
+         * @return int 0
+         */
+        int move(Number percent);
+        /**
+         * @brief Stop the motors
+         *
+         * @return int 0
+         */
+        int brake();
+        /**
+         * @brief Set the brake mode of the motors. Has no effect on the simulation
+         *
+         * @param mode the brake mode
+         * @return int 0
+         */
+        int setBrakeMode(BrakeMode mode);
+        /**
+         * @brief Get the brake mode of the motors
+         *
+         * @return BrakeMode the brake mode
+         */
+        BrakeMode getBrakeMode();
+        /**
+         * @brief Get how far the wheels have turned
+         *
+         * @return Angle the angle of the wheels
+         */
+        Angle getAngle();
+        /**
+         * @brief Get the speed of this side of the drivetrain
+         *
+         * @return LinearVelocity the speed
+         */
+        LinearVelocity getVelocity();
+        /**
+         * @brief Get the largest power the motors have been commanded
+         *
+         * @return Number the peak power, from 0 to 1
+         */
+        Number getPeakOutput();
+        /**
+         * @brief Advance the simulation
+         *
+         * @param dt how much time to simulate
+         */
+        void step(Time dt);
+    private:
+        const DrivetrainModel& m_model;
+        Number m_command = 0;
+        Number m_peakOutput = 0;
+        LinearVelocity m_velocity = 0_inps;
+        Length m_distance = 0_in;
+        BrakeMode m_brakeMode = BrakeMode::COAST;
+};
+
+/**
+ * @class SimulatedEnvironment
+ *
+ * @brief Runs a motion against a model of the drivetrain, faster than real time
+ *
+ * This class has the same interface as RobotEnvironment, but time only passes when the motion waits, and the pose is
+ * calculated from a DrivetrainModel. Actions are not run, since they would affect the real robot.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::SimulatedEnvironment env({0_in, 0_in, 0_stRad}, 10_msec, 2_sec, {});
+ * myMotion(env);
+ * const lemlib::MotionPreview preview = env.finish();
+ * @endcode
+ */
+class SimulatedEnvironment {
+    public:
+        /**
+         * @brief Construct a new Simulated Environment
+         *
+         * @param start the pose of the robot when the motion starts
+         * @param period how often the motion iterates. If it isn't positive, an error is logged and the motion
+         * doesn't run, since time would never pass
+         * @param timeout the maximum amount of time the motion can run for
+         * @param model the model of the drivetrain
+         */
+        SimulatedEnvironment(units::Pose start, Time period, Time timeout, const DrivetrainModel& model);
+        SimulatedEnvironment(const SimulatedEnvironment&) = delete;
+        SimulatedEnvironment& operator=(const SimulatedEnvironment&) = delete;
+        bool wait();
+        Time getDelta();
+        Time getTime();
+        bool isDone();
+        units::Pose getPose();
+        SimulatedMotors& getLeftMotors();
+        SimulatedMotors& getRightMotors();
+        void updateActions(ActionRunner& actions, const MotionProgress& progress);
+        /**
+         * @brief Let the robot come to a stop after the motion has ended, and get the results
+         *
+         * @return MotionPreview the predicted results of the motion. Empty if the period isn't positive
+         */
+        MotionPreview finish();
+    private:
+        /**
+         * @brief Advance the simulation
+         *
+         * @param dt how much time to simulate
+         */
+        void step(Time dt);
+
+        const DrivetrainModel m_model;
+        const Time m_period;
+        const Time m_timeout;
+        units::Pose m_pose;
+        Time m_time = 0_sec;
+        bool m_firstIteration = true;
+        SimulatedMotors m_leftMotors;
+        SimulatedMotors m_rightMotors;
+};
+} // namespace lemlib
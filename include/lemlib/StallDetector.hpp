@@ -0,0 +1,77 @@
+#pragma once
+
+#include "units/Pose.hpp"
+#include <optional>
+
+namespace lemlib {
+/**
+ * @class StallDetector
+ *
+ * @brief Detects when the drivetrain is pushing against something it can't move, like a wall or a field element
+ *
+ * The drivetrain is considered stalled when it has been commanded at least a minimum power, and the robot has not
+ * made any progress for a confidence window. Optionally, the wheels must also have been turning slower than a maximum
+ * speed, so only stalled motors are detected, and not wheels slipping against the floor.
+ *
+ * Motions which support stall detection exit as soon as the stall detector is triggered, instead of pushing until
+ * their timeout.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void autonomous() {
+ *   // exit if the robot has not moved more than 0.5 inches in 250 ms, while being commanded at least 20% power
+ *   lemlib::moveToPoint({24_in, 24_in}, 3_sec, {}, {.stallDetector = lemlib::StallDetector(250_msec)});
+ * }
+ * @endcode
+ */
+class StallDetector {
+    public:
+        /**
+         * @brief Construct a new Stall Detector
+         *
+         * @param window how long the drivetrain must be stalled before the stall detector is triggered
+         * @param maxProgress how far the robot can move during the window while still being stalled. 0.5 inches by
+         * default
+         * @param minPower the minimum power the drivetrain must be commanded for it to be stalled, from 0 to 1. 0.2
+         * by default
+         * @param maxWheelSpeed the maximum average speed of the wheels, after gearing, while stalled. Any speed by
+         * default
+         */
+        StallDetector(Time window, Length maxProgress = 0.5_in, Number minPower = 0.2,
+                      AngularVelocity maxWheelSpeed = AngularVelocity(INFINITY));
+        /**
+         * @brief Update the stall detector
+         *
+         * @param power the power the drivetrain is commanded, from -1 to 1. For drivetrains, this is typically the
+         * largest of the left and right outputs
+         * @param leftAngle the angle of the left side of the drivetrain
+         * @param rightAngle the angle of the right side of the drivetrain
+         * @param pose the current pose of the robot
+         * @param now the current time
+         *
+         * @return true the drivetrain is stalled
+         * @return false the drivetrain is not stalled
+         */
+        bool update(Number power, Angle leftAngle, Angle rightAngle, units::Pose pose, Time now);
+        /**
+         * @brief Reset the stall detector
+         */
+        void reset();
+    private:
+        /**
+         * @brief Start a new window
+         */
+        void startWindow(Angle leftAngle, Angle rightAngle, units::Pose pose, Time now);
+
+        Time m_window;
+        Length m_maxProgress;
+        Number m_minPower;
+        AngularVelocity m_maxWheelSpeed;
+
+        std::optional<Time> m_windowStart = std::nullopt;
+        units::Pose m_windowPose = {0_in, 0_in, 0_stRad};
+        Angle m_windowLeftAngle = 0_stRad;
+        Angle m_windowRightAngle = 0_stRad;
+        bool m_stalled = false;
+};
+} // namespace lemlib
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "lemlib/config.hpp"
+#include "lemlib/PoseSource.hpp"
+#include "lemlib/Simulation.hpp"
+#include "lemlib/SysIdFit.hpp"
+
+namespace lemlib {
+/**
+ * @brief The tests used to identify the drivetrain
+ */
+enum class SysIdTest {
+    /** drive forwards while slowly increasing the power, to measure kS and kV */
+    QUASISTATIC_FORWARD,
+    /** drive backwards while slowly increasing the power, to measure kS and kV */
+    QUASISTATIC_BACKWARD,
+    /** drive forwards at a constant power, starting from rest, to measure kA */
+    DYNAMIC_FORWARD,
+    /** drive backwards at a constant power, starting from rest, to measure kA */
+    DYNAMIC_BACKWARD,
+    /** turn counterclockwise in place while slowly increasing the power, to measure the track width */
+    TURN,
+};
+
+struct SysIdSettings {
+        PoseSource poseGetter = pose_getter;
+        lemlib::MotorGroup& leftMotors = left_motors;
+        lemlib::MotorGroup& rightMotors = right_motors;
+        /** the diameter of the wheels, used to convert the motor encoders to distance */
+        Length wheelDiameter = drivetrain_model.wheelDiameter;
+        Time period = motion_period;
+        /** how fast the power increases during quasistatic tests, per second */
+        Number rampRate = 0.1;
+        /** the power used during dynamic tests */
+        Number stepPower = 0.6;
+        /** the maximum amount of time a test can run for */
+        Time timeout = 5_sec;
+        /** how far the robot can drive before a straight line test is stopped */
+        Length maxDistance = 72_in;
+};
+
+/**
+ * @brief Run a system identification test on the drivetrain
+ *
+ * The robot drives on its own, so make sure it has enough space. Straight line tests stop once the robot has driven
+ * SysIdSettings::maxDistance. Like motions, the test can be cancelled with the motion handler.
+ *
+ * The samples can be fitted on the brain with fitFeedforward() and fitTrackWidth(), or written with toCsv() and
+ * fitted on a computer with the tool in tools/sysid-fit.
+ *
+ * @param test the test to run
+ * @param settings the settings of the test
+ * @return std::vector<SysIdSample> the samples measured during the test
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void autonomous() {
+ *   std::vector<std::vector<lemlib::SysIdSample>> tests;
+ *   tests.push_back(lemlib::runSysIdTest(lemlib::SysIdTest::QUASISTATIC_FORWARD));
+ *   // reposition the robot between tests
+ *   pros::delay(5000);
+ *   tests.push_back(lemlib::runSysIdTest(lemlib::SysIdTest::QUASISTATIC_BACKWARD));
+ *   pros::delay(5000);
+ *   tests.push_back(lemlib::runSysIdTest(lemlib::SysIdTest::DYNAMIC_FORWARD));
+ *   pros::delay(5000);
+ *   tests.push_back(lemlib::runSysIdTest(lemlib::SysIdTest::DYNAMIC_BACKWARD));
+ *   pros::delay(5000);
+ *   const std::vector<lemlib::SysIdSample> turn = lemlib::runSysIdTest(lemlib::SysIdTest::TURN);
+ *
+ *   lemlib::SysIdResult result = lemlib::fitFeedforward(tests);
+ *   result.trackWidth = lemlib::fitTrackWidth(turn);
+ *   std::cout << "kS: " << result.feedforward.kS << " kV: " << result.feedforward.kV
+ *             << " kA: " << result.feedforward.kA << " r^2: " << result.rSquared
+ *             << " track width: " << to_in(result.trackWidth) << std::endl;
+ * }
+ * @endcode
+ */
+std::vector<SysIdSample> runSysIdTest(SysIdTest test, const SysIdSettings& settings);
+
+/**
+ * @brief Run a system identification test on the drivetrain
+ *
+ * @param test the test to run
+ * @param settings the settings of the test
+ * @return std::vector<SysIdSample> the samples measured during the test
+ */
+std::vector<SysIdSample> runSysIdTest(SysIdTest test, SysIdSettings&& settings = {});
+} // namespace lemlib
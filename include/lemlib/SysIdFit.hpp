@@ -0,0 +1,107 @@
+#pragma once
+
+#include "lemlib/Feedforward.hpp"
+#include "lemlib/Simulation.hpp"
+#include "units/Pose.hpp"
+#include <span>
+#include <string>
+#include <vector>
+
+namespace lemlib {
+/**
+ * @brief A single measurement taken during a system identification test
+ */
+struct SysIdSample {
+        /** time since the start of the test */
+        Time time;
+        /** power commanded to the left side of the drivetrain, from -1 to 1 */
+        Number leftPower;
+        /** power commanded to the right side of the drivetrain, from -1 to 1 */
+        Number rightPower;
+        /** distance travelled by the left wheels since the start of the test, measured by the motor encoders */
+        Length leftDistance;
+        /** distance travelled by the right wheels since the start of the test, measured by the motor encoders */
+        Length rightDistance;
+        /** pose of the robot, measured by odometry */
+        units::Pose pose;
+};
+
+/**
+ * @brief The results of a system identification fit
+ */
+struct SysIdResult {
+        /** feedforward gains for each side of the drivetrain, in inches per second */
+        FeedforwardGains feedforward;
+        /** how well the gains fit the data, from 0 to 1. Values under about 0.9 mean the data is too noisy */
+        Number rSquared = 0;
+        /** the effective track width. 0 if there was no data to fit it from */
+        Length trackWidth = 0_in;
+
+        /**
+         * @brief Create a model of the drivetrain from the results, which can be used to preview motions
+         *
+         * @param wheelDiameter the diameter of the wheels
+         * @return DrivetrainModel the model
+         */
+        DrivetrainModel toModel(Length wheelDiameter) const;
+};
+
+/**
+ * @brief Fit feedforward gains to samples from straight line tests
+ *
+ * Velocity and acceleration are calculated from the encoder distances with central differences, then kS, kV and kA
+ * are found by least squares, using the samples of both sides of the drivetrain. Samples where the wheels are
+ * stationary are ignored, since static friction can hold any power below kS.
+ *
+ * @param tests the samples of each test. Tests should not be concatenated, since the differences between the end of
+ * one test and the start of the next are meaningless
+ * @return SysIdResult the fitted gains. The track width is left at 0
+ *
+ * @b Example:
+ * @code {.cpp}
+ * const std::vector<lemlib::SysIdSample> quasistatic = lemlib::runSysIdTest(lemlib::SysIdTest::QUASISTATIC_FORWARD);
+ * const std::vector<lemlib::SysIdSample> dynamic = lemlib::runSysIdTest(lemlib::SysIdTest::DYNAMIC_FORWARD);
+ * const lemlib::SysIdResult result = lemlib::fitFeedforward({quasistatic, dynamic});
+ * @endcode
+ */
+SysIdResult fitFeedforward(std::span<const std::vector<SysIdSample>> tests);
+
+/**
+ * @brief Fit feedforward gains to samples from straight line tests
+ *
+ * @param tests the samples of each test
+ * @return SysIdResult the fitted gains. The track width is left at 0
+ */
+SysIdResult fitFeedforward(std::initializer_list<std::vector<SysIdSample>> tests);
+
+/**
+ * @brief Fit the effective track width to samples from a turning test
+ *
+ * The effective track width is usually a bit larger than the measured track width, because the wheels scrub while
+ * turning. It is found by least squares on (right speed - left speed) = track width * angular velocity, where the
+ * angular velocity is measured by odometry.
+ *
+ * @param samples the samples of a turning test
+ * @return Length the effective track width. 0 if the robot did not turn
+ */
+Length fitTrackWidth(std::span<const SysIdSample> samples);
+
+/**
+ * @brief Write samples as CSV, so they can be fitted on a computer
+ *
+ * The columns are time (s), left power, right power, left distance (in), right distance (in), x (in), y (in), and
+ * heading (standard radians). The first line is a header.
+ *
+ * @param samples the samples
+ * @return std::string the CSV
+ */
+std::string toCsv(std::span<const SysIdSample> samples);
+
+/**
+ * @brief Read samples written by toCsv()
+ *
+ * @param csv the CSV
+ * @return std::vector<SysIdSample> the samples. Lines which can't be read are skipped
+ */
+std::vector<SysIdSample> fromCsv(const std::string& csv);
+} // namespace lemlib
@@ -181,6 +181,8 @@ class Timer {
         /**
          * @brief wait until the timer is done
          *
+         * The calling task sleeps until the time the timer is expected to finish, instead of polling it.
+         *
          * @b Example
          * @code {.cpp}
          * // create a timer that will wait for 1 second
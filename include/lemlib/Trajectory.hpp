@@ -0,0 +1,156 @@
+#pragma once
+
+#include "units/Pose.hpp"
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace lemlib {
+/**
+ * @brief A pose the robot should pass through in a sequence
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // pass within 2 inches of (24, 24), facing any direction
+ * lemlib::SequenceTarget target1 {{24_in, 24_in}, std::nullopt, 2_in};
+ * // pass through (48, 0) exactly, facing 90 degrees
+ * lemlib::SequenceTarget target2 {{48_in, 0_in}, 90_cDeg};
+ * @endcode
+ */
+struct SequenceTarget {
+        /** the position to pass through */
+        units::V2Position position;
+        /** the heading of the robot at the target. If std::nullopt, the heading is chosen to keep the path smooth */
+        std::optional<Angle> heading = std::nullopt;
+        /** how far the path may pass from the target, to cut corners. Ignored for the first and last targets */
+        Length tolerance = 0_in;
+};
+
+/**
+ * @brief The limits of the drivetrain, used to compile a sequence
+ */
+struct SequenceConstraints {
+        /** the top speed of the robot */
+        LinearVelocity maxSpeed = 60_inps;
+        /** the maximum acceleration of the robot, both along the path and towards the center of a turn */
+        LinearAcceleration maxAcceleration = 100_inps2;
+        /** the distance between the left and right wheels, used so the outer wheels do not exceed the top speed */
+        Length trackWidth = 12_in;
+        /** the slowest the robot is commanded to move before the end of the path, so it can start moving */
+        LinearVelocity minSpeed = 5_inps;
+        /** the distance between points of the compiled path */
+        Length spacing = 1_in;
+};
+
+/**
+ * @brief A point of a compiled trajectory
+ */
+struct TrajectoryPoint {
+        /** the pose of the robot at this point */
+        units::Pose pose;
+        /** the speed of the robot at this point */
+        LinearVelocity speed;
+        /** the curvature of the path at this point. Positive when turning counterclockwise */
+        Curvature curvature;
+        /** when the robot reaches this point, relative to the start of the trajectory */
+        Time time;
+};
+
+/**
+ * @brief A sequence of targets compiled into a single continuous trajectory
+ *
+ * The trajectory starts and ends at rest, and does not stop at the targets in between. Speeds are as high as possible
+ * while respecting the constraints it was compiled with, so it is time-optimal along its path.
+ *
+ * Trajectories can be compiled offline with the sequence compiler in tools/sequence-compiler, which writes a path file
+ * that can be followed with lemlib::follow(), or compiled on the robot and passed to lemlib::follow() directly.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * const lemlib::Trajectory trajectory = lemlib::compileSequence({
+ *     {{0_in, 0_in}, 0_cDeg},
+ *     {{24_in, 24_in}, std::nullopt, 2_in},
+ *     {{48_in, 0_in}, 180_cDeg},
+ * });
+ * lemlib::logger::info("this trajectory takes {}", trajectory.getDuration());
+ * lemlib::follow(trajectory, 10_in, trajectory.getDuration() + 1_sec, {}, {});
+ * @endcode
+ */
+class Trajectory {
+    public:
+        /**
+         * @brief Construct a new Trajectory
+         *
+         * @param points the points of the trajectory
+         * @param constraints the constraints the trajectory was compiled with
+         */
+        Trajectory(std::vector<TrajectoryPoint> points, SequenceConstraints constraints);
+        /**
+         * @brief Get the points of the trajectory
+         *
+         * @return std::span<const TrajectoryPoint> the points
+         */
+        std::span<const TrajectoryPoint> getPoints() const;
+        /**
+         * @brief Get the constraints the trajectory was compiled with
+         *
+         * @return const SequenceConstraints& the constraints
+         */
+        const SequenceConstraints& getConstraints() const;
+        /**
+         * @brief Get how long it takes to drive the trajectory, if the robot tracks it perfectly
+         *
+         * @return Time the duration
+         */
+        Time getDuration() const;
+        /**
+         * @brief Get where the robot should be at a time, interpolating between points
+         *
+         * @param time the time since the start of the trajectory. Clamped to the duration of the trajectory
+         * @return TrajectoryPoint the interpolated point. Must not be called on an empty trajectory
+         */
+        TrajectoryPoint sample(Time time) const;
+        /**
+         * @brief Get the speed to command at a point, as a fraction of the top speed
+         *
+         * The last point has a speed of 0, which marks the end of the path. Every other point is at least
+         * SequenceConstraints::minSpeed, so the robot can start moving.
+         *
+         * @param index the index of the point
+         * @return Number the speed, from 0 to 1
+         */
+        Number getCommandedSpeed(size_t index) const;
+        /**
+         * @brief Write the trajectory in the path file format read by lemlib::follow()
+         *
+         * @return std::string the contents of the path file
+         */
+        std::string toPathFile() const;
+    private:
+        std::vector<TrajectoryPoint> m_points;
+        SequenceConstraints m_constraints;
+};
+
+/**
+ * @brief Compile a sequence of targets into a single continuous trajectory
+ *
+ * A cubic Hermite spline is fitted through the targets, moving each target by up to its tolerance to cut corners.
+ * Then the speed at every point is limited by the curvature of the path and the constraints, and acceleration limits
+ * are applied forwards and backwards, starting and ending at rest.
+ *
+ * @param targets the targets, starting with the pose of the robot at the start of the sequence. Needs at least 2
+ * @param constraints the limits of the drivetrain
+ * @return Trajectory the compiled trajectory. Empty if there are less than 2 targets
+ */
+Trajectory compileSequence(std::span<const SequenceTarget> targets, const SequenceConstraints& constraints = {});
+
+/**
+ * @brief Compile a sequence of targets into a single continuous trajectory
+ *
+ * @param targets the targets, starting with the pose of the robot at the start of the sequence. Needs at least 2
+ * @param constraints the limits of the drivetrain
+ * @return Trajectory the compiled trajectory. Empty if there are less than 2 targets
+ */
+Trajectory compileSequence(std::initializer_list<SequenceTarget> targets, const SequenceConstraints& constraints = {});
+} // namespace lemlib
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "hardware/Motor/MotorGroup.hpp"
+#include "pros/rtos.hpp"
+#include <cstdint>
+#include <optional>
+
+namespace lemlib {
+/**
+ * @class VoltageCompensator
+ *
+ * @brief Scales motor outputs so they have the same effect at any battery voltage
+ *
+ * A motor commanded a percent of full power gets that percent of the battery voltage, so the same command drives the
+ * robot faster on a full battery than on a tired one. The compensator scales commands by the nominal voltage over the
+ * battery voltage, so gains and profiles tuned at the nominal voltage hold for a whole match.
+ *
+ * The battery voltage drops briefly whenever the motors draw a lot of current, so it is only read every period, and
+ * low pass filtered. The compensator follows how the battery drains over a match, not how it sags during a motion.
+ *
+ * One compensator can be shared by motions running in different tasks, since reading it is guarded by a mutex.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::VoltageCompensator compensator(12_volt);
+ *
+ * // every motion scales its outputs with the compensator
+ * lemlib::VoltageCompensator* const voltage_compensation = &compensator;
+ * @endcode
+ */
+class VoltageCompensator {
+    public:
+        /**
+         * @brief Construct a new Voltage Compensator
+         *
+         * @param nominalVoltage the voltage gains were tuned at. 12 volts by default
+         * @param timeConstant the time constant of the low pass filter. 1 second by default
+         * @param period how often the battery voltage is read. 100 ms by default
+         */
+        VoltageCompensator(Voltage nominalVoltage = 12_volt, Time timeConstant = 1_sec, Time period = 100_msec);
+        /**
+         * @brief Get how much outputs should be scaled by, reading the battery if it is due
+         *
+         * @return Number the nominal voltage divided by the filtered battery voltage. 1 until the battery is read
+         */
+        Number getScale();
+        /**
+         * @brief Get the filtered battery voltage, reading the battery if it is due
+         *
+         * @return std::optional<Voltage> the filtered voltage. std::nullopt if the battery hasn't been read yet
+         */
+        std::optional<Voltage> getVoltage();
+    private:
+        /**
+         * @brief Read the battery and update the filter, if the period has passed since the last attempt to read it.
+         * The mutex must be held
+         */
+        void update();
+
+        Voltage m_nominalVoltage;
+        Time m_timeConstant;
+        Time m_period;
+        std::optional<Voltage> m_voltage = std::nullopt;
+        std::uint64_t m_lastRead = 0;
+        std::optional<std::uint64_t> m_lastAttempt = std::nullopt;
+        bool m_readFailed = false;
+        pros::Mutex m_mutex;
+};
+
+/**
+ * @class CompensatedMotors
+ *
+ * @brief A motor group whose power commands are scaled by a voltage compensator. Has the same interface as
+ * MotorGroup, as far as motions are concerned
+ */
+class CompensatedMotors {
+    public:
+        /**
+         * @brief Construct a new Compensated Motors object
+         *
+         * @param motors the motors to command
+         * @param compensator the compensator to scale commands with. If nullptr, commands are not scaled
+         */
+        CompensatedMotors(MotorGroup& motors, VoltageCompensator* compensator);
+        /**
+         * @brief Command the motors, scaled by the compensator
+         *
+         * @param percent the power at the nominal voltage, from -1 to 1
+         * @return int the result of MotorGroup::move()
+         */
+        int move(Number percent);
+        /**
+         * @brief Stop the motors. See MotorGroup::brake()
+         */
+        int brake();
+        /**
+         * @brief Set the brake mode of the motors. See MotorGroup::setBrakeMode()
+         */
+        int setBrakeMode(BrakeMode mode);
+        /**
+         * @brief Get the brake mode of the motors. See MotorGroup::getBrakeMode()
+         */
+        BrakeMode getBrakeMode();
+        /**
+         * @brief Get how far the motors have turned. See MotorGroup::getAngle()
+         */
+        Angle getAngle();
+    private:
+        MotorGroup& m_motors;
+        VoltageCompensator* m_compensator;
+};
+} // namespace lemlib
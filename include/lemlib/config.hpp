@@ -8,6 +8,17 @@
 #include "units/Pose.hpp"
 #include <functional>
 
+namespace logger {
+enum class Level;
+} // namespace logger
+
+namespace lemlib {
+class Event;
+class VoltageCompensator;
+class UnicycleLQR;
+struct DrivetrainModel;
+} // namespace lemlib
+
 extern const lemlib::PID angular_pid;
 extern const lemlib::PID lateral_pid;
 
@@ -24,4 +35,25 @@ extern const Length track_width;
 extern const Number drift_compensation;
 
 extern const Number angular_slew;
-extern const Number lateral_slew;
\ No newline at end of file
+extern const Number lateral_slew;
+
+// the values below have defaults provided by LemLib, which can be overridden by defining them
+
+/** event motions iterate on by default. If nullptr, motions iterate on a fixed period. nullptr by default */
+extern lemlib::Event* const motion_trigger;
+/** how quickly the lateral slew rate can change by default, per second. 0 only limits the rate. 0 by default */
+extern const Number lateral_jerk;
+/** compensator motions scale their outputs with, so they behave the same at any battery voltage. If nullptr, outputs
+ * are not compensated. nullptr by default */
+extern lemlib::VoltageCompensator* const voltage_compensation;
+/** lowest level of the messages motions log. Messages below it are skipped before they are formatted, which
+ * allocates memory. Moving to points and poses and turning only log debug messages unless something goes wrong, so
+ * they don't allocate at the default level. INFO by default */
+extern const logger::Level log_level;
+/** how often motions iterate by default. 10 ms by default */
+extern const Time motion_period;
+/** model of the drivetrain used to preview motions. See DrivetrainModel for the defaults */
+extern const lemlib::DrivetrainModel drivetrain_model;
+/** returns the controller trackTrajectory uses by default. The default controller is constructed, which precomputes
+ * its gains, the first time it is used. See UnicycleLQR for the defaults */
+extern const lemlib::UnicycleLQR& trajectory_controller();
@@ -4,12 +4,17 @@
 #include "lemlib/macros.hpp" // IWYU pragma: keep
 #endif
 
+#include "lemlib/motions/autotune.hpp" // IWYU pragma: keep
 #include "lemlib/motions/follow.hpp" // IWYU pragma: keep
 #include "lemlib/motions/moveToPoint.hpp" // IWYU pragma: keep
 #include "lemlib/motions/moveToPose.hpp" // IWYU pragma: keep
+#include "lemlib/motions/moveToPoseMPC.hpp" // IWYU pragma: keep
+#include "lemlib/motions/trackTrajectory.hpp" // IWYU pragma: keep
 #include "lemlib/motions/turnTo.hpp" // IWYU pragma: keep
 #include "lemlib/tracking/TrackingWheelOdom.hpp" // IWYU pragma: keep
 #include "lemlib/MotionHandler.hpp" // IWYU pragma: keep
+#include "lemlib/SysId.hpp" // IWYU pragma: keep
+#include "lemlib/VoltageCompensation.hpp" // IWYU pragma: keep
 
 #ifndef LEMLIB_NO_ALIAS
 namespace ll = lemlib;
@@ -2,18 +2,24 @@
 
 #include "pros/rtos.hpp" // IWYU pragma: keep
 #include "lemlib/MotionHandler.hpp" // IWYU pragma: keep
+#include "lemlib/Event.hpp" // IWYU pragma: keep
 
 /**
  * @brief this macro can be used to greatly simplify passing motion algorithms to the motion handler
  *
+ * Local variables are captured by value, since the motion is queued and may run after they have changed or gone out
+ * of scope. The copies are mutable, so they can be passed to motions which take their settings by reference.
+ *
  * @b Example:
  * @code {.cpp}
  * void autonomous() {
  *   MOVE_CUSTOM(simpleMotion())
+ *   // each motion gets its own copy of the point
+ *   for (units::V2Position point : points) MOVE_CUSTOM(lemlib::moveToPoint(point, 2_sec, {}, {}))
  * }
  * @endcode
  */
-#define MOVE_CUSTOM(f) lemlib::motion_handler::move([&] { f; });
+#define MOVE_CUSTOM(f) lemlib::motion_handler::move([=]() mutable { f; });
 
 /**
  * @brief this macro can be used to wait until a condition has been met
@@ -32,3 +38,22 @@
  */
 #define WAIT_UNTIL(c)                                                                                                  \
     while (!(c)) pros::delay(5);
+
+/**
+ * @brief this macro can be used to wait until a condition has been met, checking it every time an event is published
+ *
+ * Unlike WAIT_UNTIL, the condition is checked as soon as the event is published, so there is no polling delay.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void autonomous() {
+ *   MOVE_CUSTOM(lemlib::moveToPoint({24_in, 24_in}, 2_sec, {}, {}))
+ *   // wait until the robot is past y = 12 inches, checking every time the pose is updated
+ *   WAIT_UNTIL_EVENT(odom.getPose().y > 12_in, odom.getPoseEvent())
+ *   intake.move(1);
+ *   // wait until the motion has finished, checking every time a motion iterates
+ *   WAIT_UNTIL_EVENT(!lemlib::motion_handler::isMoving(), lemlib::motion_handler::getProgressEvent())
+ * }
+ * @endcode
+ */
+#define WAIT_UNTIL_EVENT(c, event) lemlib::waitUntil([&] { return bool(c); }, event);
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "lemlib/config.hpp"
+#include "lemlib/PoseSource.hpp"
+
+namespace lemlib {
+/**
+ * @brief Rules used to calculate PID gains from the ultimate gain and period
+ */
+enum class TuningRule {
+    /** classic Ziegler-Nichols. Fast, but with a lot of overshoot */
+    ZIEGLER_NICHOLS,
+    /** Ziegler-Nichols without an integral term, which suits most drivetrain motions */
+    ZIEGLER_NICHOLS_PD,
+    /** Tyreus-Luyben. Slower than Ziegler-Nichols, but more robust */
+    TYREUS_LUYBEN,
+    /** Pessen integral rule. Rejects disturbances quickly */
+    PESSEN_INTEGRAL,
+    /** Ziegler-Nichols variant with some overshoot */
+    SOME_OVERSHOOT,
+    /** Ziegler-Nichols variant with little to no overshoot */
+    NO_OVERSHOOT,
+};
+
+/**
+ * @brief Which controller to tune
+ */
+enum class AutotuneMode {
+    /** turn in place around the starting heading. Gains are for angular errors in radians, like turnTo */
+    ANGULAR,
+    /** drive back and forth around the starting position. Gains are for lateral errors in meters, like moveToPoint */
+    LATERAL,
+};
+
+/**
+ * @brief Parameters for autotune
+ */
+struct AutotuneParams {
+        /** the rule used to calculate the gains. ZIEGLER_NICHOLS_PD by default */
+        TuningRule rule = TuningRule::ZIEGLER_NICHOLS_PD;
+        /** the power of the relay, from 0 to 1. Should be enough to overcome friction. 0.4 by default */
+        Number relayPower = 0.4;
+        /** the relay only switches once the error has crossed zero by this much, in radians or meters, so noise does
+         * not make it chatter. 0.01 by default */
+        Number hysteresis = 0.01;
+        /** how many oscillations are measured, after the first one is skipped. At least 1 is measured. 3 by default */
+        int cycles = 3;
+};
+
+/**
+ * @brief Settings for autotune
+ */
+struct AutotuneSettings {
+        /** returns the estimated pose of the robot, typically the tracking wheel odometry. Not owned by the settings */
+        PoseSource poseGetter = pose_getter;
+        /** the left motor group of the drivetrain */
+        lemlib::MotorGroup& leftMotors = left_motors;
+        /** the right motor group of the drivetrain */
+        lemlib::MotorGroup& rightMotors = right_motors;
+        /** if set, the motion iterates every time this event is published, instead of on a fixed period */
+        lemlib::Event* trigger = motion_trigger;
+        /** how often the motion iterates. Should not be shorter than the odometry period */
+        Time period = motion_period;
+};
+
+/**
+ * @brief The results of autotune
+ */
+struct AutotuneResult {
+        /** whether enough oscillations were measured before the timeout. If false, the other fields are not valid */
+        bool success = false;
+        /** the ultimate gain, the proportional gain at which the system oscillates steadily */
+        Number ultimateGain = 0;
+        /** the ultimate period, the period of the oscillations */
+        Time ultimatePeriod = 0_sec;
+        /** the recommended gains */
+        Gains gains = {};
+};
+
+/**
+ * @brief Calculate PID gains from the ultimate gain and period of a system
+ *
+ * @param ultimateGain the ultimate gain
+ * @param ultimatePeriod the ultimate period
+ * @param rule the rule to use
+ * @return Gains the recommended gains
+ */
+Gains computeGains(Number ultimateGain, Time ultimatePeriod, TuningRule rule);
+
+/**
+ * @brief Tune a PID controller with a relay experiment
+ *
+ * The drivetrain is driven with a relay: full relay power one way while the error is positive, and the other way
+ * while it is negative. This makes the robot oscillate around where it started, at the ultimate period of the system.
+ * The ultimate gain is calculated from the amplitude of the oscillations, and the gains are calculated from both with
+ * the chosen rule. A tune usually takes a few seconds.
+ *
+ * @param mode which controller to tune
+ * @param pid the PID controller to write the recommended gains to. Only written if the tune succeeded
+ * @param timeout the maximum amount of time the tune can run for
+ * @param params the parameters of the tune
+ * @param settings the settings of the tune
+ * @return AutotuneResult the measurements and recommended gains
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::PID turnPID(0, 0, 0);
+ *
+ * void autonomous() {
+ *   const lemlib::AutotuneResult result = lemlib::autotune(lemlib::AutotuneMode::ANGULAR, turnPID, 5_sec, {}, {});
+ *   if (result.success) lemlib::turnTo(90_cDeg, 2_sec, {}, {.angularPID = turnPID});
+ * }
+ * @endcode
+ */
+AutotuneResult autotune(AutotuneMode mode, PID& pid, Time timeout, const AutotuneParams& params,
+                        AutotuneSettings&& settings);
+
+/**
+ * @brief Tune a PID controller with a relay experiment
+ *
+ * @param mode which controller to tune
+ * @param pid the PID controller to write the recommended gains to. Only written if the tune succeeded
+ * @param timeout the maximum amount of time the tune can run for
+ * @param params the parameters of the tune
+ * @param settings the settings of the tune
+ * @return AutotuneResult the measurements and recommended gains
+ */
+AutotuneResult autotune(AutotuneMode mode, PID& pid, Time timeout, const AutotuneParams& params,
+                        const AutotuneSettings& settings);
+} // namespace lemlib
@@ -1,20 +1,94 @@
 #pragma once
 
 #include "lemlib/config.hpp"
+#include "lemlib/Feedforward.hpp"
+#include "lemlib/MotionActions.hpp"
+#include "lemlib/PoseSource.hpp"
+#include "lemlib/Simulation.hpp"
+#include "lemlib/Trajectory.hpp"
 #include "hot-cold-asset/asset.hpp"
+#include <optional>
 
 namespace lemlib {
 struct FollowParams {
         bool reversed = false;
         Number lateralSlew = lateral_slew;
+        Number lateralJerk = lateral_jerk;
+        std::vector<MotionAction> actions = {};
 };
 
 struct FollowSettings {
         Length trackWidth = track_width;
-        std::function<units::Pose()> poseGetter = pose_getter;
+        PoseSource poseGetter = pose_getter;
         lemlib::MotorGroup& leftMotors = left_motors;
         lemlib::MotorGroup& rightMotors = right_motors;
+        lemlib::Event* trigger = motion_trigger;
+        Time period = motion_period;
+        /**
+         * feedforward for each side of the drivetrain, tuned in inches per second. When following a compiled
+         * trajectory, each side tracks the planned velocity and acceleration with feedforward, instead of commanding
+         * a fraction of the top speed. Unused for paths without planned velocities
+         */
+        std::optional<Feedforward> feedforward = std::nullopt;
 };
 
-void follow(const asset& path, Length lookaheadDistance, Time timeout, FollowParams params, FollowSettings settings);
+void follow(const asset& path, Length lookaheadDistance, Time timeout, const FollowParams& params,
+            FollowSettings& settings);
+
+void follow(const asset& path, Length lookaheadDistance, Time timeout, const FollowParams& params,
+            FollowSettings&& settings);
+
+/**
+ * @brief Follow a compiled trajectory
+ *
+ * The robot drives the whole trajectory without stopping, using the speeds the trajectory was compiled with. See
+ * compileSequence()
+ *
+ * @param trajectory the trajectory to follow
+ * @param lookaheadDistance the lookahead distance
+ * @param timeout the maximum amount of time the motion can run for
+ * @param params the parameters of the motion. The lateral slew should be high enough to not limit the acceleration of
+ * the trajectory
+ * @param settings the settings of the motion. If it has feedforward, the planned velocity and acceleration of the
+ * trajectory are tracked with it
+ *
+ * @b Example:
+ * @code {.cpp}
+ * const lemlib::Trajectory trajectory = lemlib::compileSequence({
+ *     {{0_in, 0_in}, 0_cDeg},
+ *     {{24_in, 24_in}, std::nullopt, 2_in},
+ *     {{48_in, 0_in}, 180_cDeg},
+ * });
+ * lemlib::follow(trajectory, 10_in, trajectory.getDuration() + 1_sec, {}, {});
+ * @endcode
+ */
+void follow(const Trajectory& trajectory, Length lookaheadDistance, Time timeout, const FollowParams& params,
+            FollowSettings& settings);
+
+void follow(const Trajectory& trajectory, Length lookaheadDistance, Time timeout, const FollowParams& params,
+            FollowSettings&& settings);
+
+/**
+ * @brief Predict the result of follow, by running it against a model of the drivetrain
+ *
+ * The motion runs with the same control law as on the robot, but faster than real time and without moving the robot.
+ * Actions are not run.
+ *
+ * @param path the path to follow
+ * @param lookaheadDistance the lookahead distance
+ * @param timeout the maximum amount of time the motion can run for
+ * @param params the parameters of the motion
+ * @param settings the settings of the motion. Copied, so the settings of the real motion are not affected
+ * @param start the pose of the robot when the motion starts
+ * @param model the model of the drivetrain
+ * @return MotionPreview how long the motion will take, where it will end, and the peak motor outputs
+ *
+ * @b Example:
+ * @code {.cpp}
+ * const lemlib::MotionPreview preview = lemlib::previewFollow(myPath, 10_in, 5_sec, {}, {}, odom.getPose());
+ * @endcode
+ */
+MotionPreview previewFollow(const asset& path, Length lookaheadDistance, Time timeout, const FollowParams& params,
+                            FollowSettings settings, units::Pose start,
+                            const DrivetrainModel& model = drivetrain_model);
 } // namespace lemlib
\ No newline at end of file
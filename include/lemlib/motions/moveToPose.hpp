@@ -1,6 +1,10 @@
 #pragma once
 
 #include "lemlib/config.hpp"
+#include "lemlib/MotionActions.hpp"
+#include "lemlib/PoseSource.hpp"
+#include "lemlib/Simulation.hpp"
+#include "lemlib/StallDetector.hpp"
 #include <functional>
 
 namespace lemlib {
@@ -13,8 +17,10 @@ struct MoveToPoseParams {
         Number minLateralSpeed = 0;
         Number maxAngularSpeed = 1;
         Number lateralSlew = lateral_slew;
+        Number lateralJerk = lateral_jerk;
         Number angularSlew = angular_slew;
         Length earlyExitRange = 0_in;
+        std::vector<MotionAction> actions = {};
 };
 
 struct MoveToPoseSettings {
@@ -22,11 +28,41 @@ struct MoveToPoseSettings {
         PID lateralPID = lateral_pid;
         ExitConditionGroup<Length> lateralExitConditions = lateral_exit_conditions;
         ExitConditionGroup<AngleRange> angularExitConditions = angular_exit_conditions;
-        std::function<units::Pose()> poseGetter = pose_getter;
+        PoseSource poseGetter = pose_getter;
         lemlib::MotorGroup& leftMotors = left_motors;
         lemlib::MotorGroup& rightMotors = right_motors;
+        lemlib::Event* trigger = motion_trigger;
+        Time period = motion_period;
+        Time lateralPeriod = 0_msec;
+        std::optional<StallDetector> stallDetector = std::nullopt;
 };
 
-void moveToPose(units::Pose target, Time timeout, MoveToPoseParams params, MoveToPoseSettings settings);
+void moveToPose(units::Pose target, Time timeout, const MoveToPoseParams& params, MoveToPoseSettings& settings);
+
+void moveToPose(units::Pose target, Time timeout, const MoveToPoseParams& params, MoveToPoseSettings&& settings);
+
+/**
+ * @brief Predict the result of moveToPose, by running it against a model of the drivetrain
+ *
+ * The motion runs with the same control law as on the robot, but faster than real time and without moving the robot.
+ * Actions are not run.
+ *
+ * @param target the target pose
+ * @param timeout the maximum amount of time the motion can run for
+ * @param params the parameters of the motion
+ * @param settings the settings of the motion. Copied, so the settings of the real motion are not affected
+ * @param start the pose of the robot when the motion starts
+ * @param model the model of the drivetrain
+ * @return MotionPreview how long the motion will take, where it will end, and the peak motor outputs
+ *
+ * @b Example:
+ * @code {.cpp}
+ * const lemlib::MotionPreview preview =
+ *     lemlib::previewMoveToPose({24_in, 24_in, 90_cDeg}, 2_sec, {}, {}, odom.getPose());
+ * @endcode
+ */
+MotionPreview previewMoveToPose(units::Pose target, Time timeout, const MoveToPoseParams& params,
+                                MoveToPoseSettings settings, units::Pose start,
+                                const DrivetrainModel& model = drivetrain_model);
 
 }; // namespace lemlib
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "lemlib/config.hpp"
+#include "lemlib/Feedforward.hpp"
+#include "lemlib/MotionActions.hpp"
+#include "lemlib/MPC.hpp"
+#include "lemlib/PoseSource.hpp"
+#include "lemlib/Simulation.hpp"
+#include <optional>
+
+namespace lemlib {
+/**
+ * @brief Parameters for moveToPoseMPC
+ */
+struct MoveToPoseMPCParams {
+        /** actions to run during the motion, based on its progress */
+        std::vector<MotionAction> actions = {};
+};
+
+/**
+ * @brief Settings for moveToPoseMPC
+ */
+struct MoveToPoseMPCSettings {
+        /** the model predictive controller, which holds the limits of the drivetrain and the cost weights */
+        PoseMPC controller = PoseMPC();
+        /** feedforward for each side of the drivetrain, tuned in inches per second. If std::nullopt, each side is
+         * commanded as a fraction of maxSpeed */
+        std::optional<Feedforward> feedforward = std::nullopt;
+        /** the speed of each side of the drivetrain at full power, used when there is no feedforward */
+        LinearVelocity maxSpeed = drivetrain_model.maxSpeed;
+        /** the distance between the left and right wheels */
+        Length trackWidth = track_width;
+        /** the motion exits once the distance to the target and the heading error meet these exit conditions */
+        ExitConditionGroup<Length> lateralExitConditions = lateral_exit_conditions;
+        ExitConditionGroup<AngleRange> angularExitConditions = angular_exit_conditions;
+        /** returns the estimated pose of the robot, typically the tracking wheel odometry. Not owned by the settings */
+        PoseSource poseGetter = pose_getter;
+        /** the left motor group of the drivetrain */
+        lemlib::MotorGroup& leftMotors = left_motors;
+        /** the right motor group of the drivetrain */
+        lemlib::MotorGroup& rightMotors = right_motors;
+        /** if set, the motion iterates every time this event is published, instead of on a fixed period */
+        lemlib::Event* trigger = motion_trigger;
+        /** how often the motion iterates. Each solve has to finish well within this period */
+        Time period = motion_period;
+};
+
+/**
+ * @brief Move the robot to a pose with model predictive control
+ *
+ * Instead of chasing a carrot point like moveToPose, the controller plans the velocities of the robot over a short
+ * horizon, then commands the first planned velocities, every iteration. The plan respects the velocity and
+ * acceleration limits of the controller, so there is no need for slew or drift compensation, and the robot may back
+ * up to line up with the target if the constraints allow it. See PoseMPC.
+ *
+ * How long each solve takes is measured, and logged when the motion ends. A warning is logged if a solve took longer
+ * than the period of the motion.
+ *
+ * @param target the target pose
+ * @param timeout the maximum amount of time the motion can run for
+ * @param params the parameters of the motion
+ * @param settings the settings of the motion. The controller keeps its plan between iterations, so it is modified
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::MoveToPoseMPCSettings mpcSettings {.controller = lemlib::PoseMPC({.maxLinear = 50_inps})};
+ *
+ * void autonomous() {
+ *   lemlib::moveToPoseMPC({24_in, 24_in, 90_cDeg}, 3_sec, {}, mpcSettings);
+ * }
+ * @endcode
+ */
+void moveToPoseMPC(units::Pose target, Time timeout, const MoveToPoseMPCParams& params,
+                   MoveToPoseMPCSettings& settings);
+
+/**
+ * @brief Move the robot to a pose with model predictive control
+ *
+ * @param target the target pose
+ * @param timeout the maximum amount of time the motion can run for
+ * @param params the parameters of the motion
+ * @param settings the settings of the motion
+ */
+void moveToPoseMPC(units::Pose target, Time timeout, const MoveToPoseMPCParams& params,
+                   MoveToPoseMPCSettings&& settings);
+
+/**
+ * @brief Predict the result of moveToPoseMPC, by running it against a model of the drivetrain
+ *
+ * The motion runs with the same control law as on the robot, but faster than real time and without moving the robot.
+ * Actions are not run.
+ *
+ * @param target the target pose
+ * @param timeout the maximum amount of time the motion can run for
+ * @param params the parameters of the motion
+ * @param settings the settings of the motion. Copied, so the settings of the real motion are not affected
+ * @param start the pose of the robot when the motion starts
+ * @param model the model of the drivetrain
+ * @return MotionPreview how long the motion will take, where it will end, and the peak motor outputs
+ */
+MotionPreview previewMoveToPoseMPC(units::Pose target, Time timeout, const MoveToPoseMPCParams& params,
+                                   MoveToPoseMPCSettings settings, units::Pose start,
+                                   const DrivetrainModel& model = drivetrain_model);
+} // namespace lemlib
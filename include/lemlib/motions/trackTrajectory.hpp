@@ -0,0 +1,104 @@
+#pragma once
+
+#include "lemlib/config.hpp"
+#include "lemlib/Feedforward.hpp"
+#include "lemlib/LQR.hpp"
+#include "lemlib/MotionActions.hpp"
+#include "lemlib/PoseSource.hpp"
+#include "lemlib/Simulation.hpp"
+#include "lemlib/Trajectory.hpp"
+#include <optional>
+
+namespace lemlib {
+/**
+ * @brief Parameters for trackTrajectory
+ */
+struct TrackTrajectoryParams {
+        /** actions to run during the motion, based on its progress */
+        std::vector<MotionAction> actions = {};
+};
+
+/**
+ * @brief Settings for trackTrajectory
+ */
+struct TrackTrajectorySettings {
+        /** the state-space controller. Not owned by the settings, since constructing it precomputes its gains */
+        const UnicycleLQR& controller = trajectory_controller();
+        /** feedforward for each side of the drivetrain, tuned in inches per second. If std::nullopt, each side is
+         * commanded as a fraction of the top speed of the trajectory */
+        std::optional<Feedforward> feedforward = std::nullopt;
+        /** the distance between the left and right wheels */
+        Length trackWidth = track_width;
+        /** returns the estimated pose of the robot, typically the tracking wheel odometry. Not owned by the settings */
+        PoseSource poseGetter = pose_getter;
+        /** the left motor group of the drivetrain */
+        lemlib::MotorGroup& leftMotors = left_motors;
+        /** the right motor group of the drivetrain */
+        lemlib::MotorGroup& rightMotors = right_motors;
+        /** if set, the motion iterates every time this event is published, instead of on a fixed period */
+        lemlib::Event* trigger = motion_trigger;
+        /** how often the motion iterates. Should match the period the controller was constructed with */
+        Time period = motion_period;
+};
+
+/**
+ * @brief Track a compiled trajectory in time with a state-space controller
+ *
+ * Unlike follow(), which chases a lookahead point, the robot tracks where the trajectory says it should be at every
+ * moment. The pose, speed and curvature of the trajectory are sampled at the current time, and the controller
+ * corrects the errors along the path, across the path and in heading together. The motion ends when the duration of
+ * the trajectory has passed, or on timeout.
+ *
+ * @param trajectory the trajectory to track
+ * @param timeout the maximum amount of time the motion can run for
+ * @param params the parameters of the motion
+ * @param settings the settings of the motion
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // gains are precomputed once, for the top speed of the trajectories
+ * const lemlib::UnicycleLQR lqr({}, 60_inps);
+ * lemlib::TrackTrajectorySettings trackSettings {.controller = lqr};
+ *
+ * void autonomous() {
+ *   const lemlib::Trajectory trajectory = lemlib::compileSequence({
+ *       {{0_in, 0_in}, 0_cDeg},
+ *       {{24_in, 24_in}, std::nullopt, 2_in},
+ *       {{48_in, 0_in}, 180_cDeg},
+ *   });
+ *   lemlib::trackTrajectory(trajectory, trajectory.getDuration() + 1_sec, {}, trackSettings);
+ * }
+ * @endcode
+ */
+void trackTrajectory(const Trajectory& trajectory, Time timeout, const TrackTrajectoryParams& params,
+                     TrackTrajectorySettings& settings);
+
+/**
+ * @brief Track a compiled trajectory in time with a state-space controller
+ *
+ * @param trajectory the trajectory to track
+ * @param timeout the maximum amount of time the motion can run for
+ * @param params the parameters of the motion
+ * @param settings the settings of the motion
+ */
+void trackTrajectory(const Trajectory& trajectory, Time timeout, const TrackTrajectoryParams& params,
+                     TrackTrajectorySettings&& settings);
+
+/**
+ * @brief Predict the result of trackTrajectory, by running it against a model of the drivetrain
+ *
+ * The motion runs with the same control law as on the robot, but faster than real time and without moving the robot.
+ * Actions are not run.
+ *
+ * @param trajectory the trajectory to track
+ * @param timeout the maximum amount of time the motion can run for
+ * @param params the parameters of the motion
+ * @param settings the settings of the motion. Copied, so the settings of the real motion are not affected
+ * @param start the pose of the robot when the motion starts
+ * @param model the model of the drivetrain
+ * @return MotionPreview how long the motion will take, where it will end, and the peak motor outputs
+ */
+MotionPreview previewTrackTrajectory(const Trajectory& trajectory, Time timeout, const TrackTrajectoryParams& params,
+                                     TrackTrajectorySettings settings, units::Pose start,
+                                     const DrivetrainModel& model = drivetrain_model);
+} // namespace lemlib
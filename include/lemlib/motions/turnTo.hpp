@@ -1,11 +1,39 @@
 #pragma once
 
 #include "lemlib/config.hpp"
+#include "lemlib/Feedforward.hpp"
+#include "lemlib/MotionActions.hpp"
+#include "lemlib/PoseSource.hpp"
+#include "lemlib/Simulation.hpp"
 #include "lemlib/util.hpp"
 #include <functional>
+#include <optional>
+#include <variant>
 
 namespace lemlib {
 
+/**
+ * @brief Limits used to generate the angular velocity profile of a profiled turn
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // trapezoidal profile
+ * lemlib::TurnProfile trapezoid {.maxVelocity = 400_degps, .maxAcceleration = 1500_degps2};
+ * // S-curve profile, which takes 50 ms to reach the max acceleration
+ * lemlib::TurnProfile sCurve {.maxVelocity = 400_degps, .maxAcceleration = 1500_degps2, .jerkTime = 50_msec};
+ * @endcode
+ */
+struct TurnProfile {
+        /** the fastest the robot can turn. Should be a bit below the top speed of the drivetrain, so the controllers
+         * have room to correct errors */
+        AngularVelocity maxVelocity = 360_degps;
+        /** the maximum angular acceleration and deceleration */
+        AngularAcceleration maxAcceleration = 1080_degps2;
+        /** how long the acceleration takes to ramp up to its maximum. 0 for a trapezoidal profile, which is the
+         * default. Anything else limits jerk, making an S-curve profile */
+        Time jerkTime = 0_sec;
+};
+
 /**
  * @brief Parameters for Chassis::turnToHeading
  *
@@ -30,6 +58,12 @@ struct TurnToParams {
         /** angle between the robot and target point where the movement will exit. Only has an effect if minSpeed is
          * non-zero.*/
         AngleRange earlyExitRange = 0_cRot;
+        /** if set, the turn follows a time-optimal angular velocity profile instead of slewing the output of the
+         * angular PID. The profile is tracked with feedforward and PID on the angular velocity, then the angular PID
+         * holds the target. std::nullopt by default */
+        std::optional<TurnProfile> profile = std::nullopt;
+        /** callbacks which run once during the turn, when their condition is met */
+        std::vector<MotionAction> actions = {};
 };
 
 /**
@@ -44,14 +78,54 @@ struct TurnToSettings {
         PID angularPID = angular_pid;
         /** the exit conditions that will cause the robot to stop moving */
         ExitConditionGroup<AngleRange> exitConditions = angular_exit_conditions;
-        /** this function should return the estimated pose of the robot, typically by the tracking wheel odometry. */
-        std::function<units::Pose()> poseGetter = pose_getter;
+        /** feedforward for profiled turns, tuned in degrees per second while turning in place. If std::nullopt, the
+         * planned angular velocity is converted to power with the track width, max speed and time constant */
+        std::optional<Feedforward> angularFeedforward = std::nullopt;
+        /** PID for profiled turns, which corrects the angular velocity of the robot. Errors are in radians per
+         * second. Disabled by default */
+        PID ratePID = PID(0, 0, 0);
+        /** the distance between the left and right wheels. Used by profiled turns */
+        Length trackWidth = track_width;
+        /** the speed of each side of the drivetrain at full power. Used by profiled turns without a feedforward */
+        LinearVelocity maxSpeed = drivetrain_model.maxSpeed;
+        /** how quickly each side of the drivetrain reaches its commanded speed. Used by profiled turns without a
+         * feedforward */
+        Time timeConstant = drivetrain_model.timeConstant;
+        /** returns the estimated pose of the robot, typically the tracking wheel odometry. Not owned by the settings */
+        PoseSource poseGetter = pose_getter;
         /** the left motor group of the drivetrain */
         lemlib::MotorGroup& leftMotors = left_motors;
         /** the right motor group of the drivetrain */
         lemlib::MotorGroup& rightMotors = right_motors;
+        /** if set, the motion iterates every time this event is published, instead of on a fixed period */
+        lemlib::Event* trigger = motion_trigger;
+        /** how often the motion iterates. Should not be shorter than the odometry period */
+        Time period = motion_period;
 };
 
+/**
+ * @brief Turn the robot to face a heading or position
+ *
+ * @param target the target to turn to. Can be an angle, or a position
+ * @param timeout the maximum amount of time the motion can run for
+ * @param params struct containing parameters for the turn
+ * @param settings struct containing settings for the turn. The PID and exit conditions are reset when the motion
+ * starts, and used in place, so settings can be created once and reused without copying or allocating
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // created once, and reused by every turn
+ * lemlib::TurnToSettings turnSettings;
+ *
+ * void autonomous() {
+ *   lemlib::turnTo(90_cDeg, 2_sec, {}, turnSettings);
+ *   lemlib::turnTo(0_cDeg, 2_sec, {}, turnSettings);
+ * }
+ * @endcode
+ */
+void turnTo(std::variant<Angle, units::V2Position> target, Time timeout, const TurnToParams& params,
+            TurnToSettings& settings);
+
 /**
  * @brief Turn the robot to face a heading or position
  *
@@ -60,5 +134,29 @@ struct TurnToSettings {
  * @param params struct containing parameters for the turn
  * @param settings struct containing settings for the turn
  */
-void turnTo(std::variant<Angle, units::V2Position> target, Time timeout, TurnToParams params, TurnToSettings settings);
+void turnTo(std::variant<Angle, units::V2Position> target, Time timeout, const TurnToParams& params,
+            TurnToSettings&& settings);
+
+/**
+ * @brief Predict the result of turnTo, by running it against a model of the drivetrain
+ *
+ * The motion runs with the same control law as on the robot, but faster than real time and without moving the robot.
+ * Actions are not run.
+ *
+ * @param target the target to turn to. Can be an angle, or a position
+ * @param timeout the maximum amount of time the motion can run for
+ * @param params the parameters of the turn
+ * @param settings the settings of the motion. Copied, so the settings of the real motion are not affected
+ * @param start the pose of the robot when the motion starts
+ * @param model the model of the drivetrain
+ * @return MotionPreview how long the motion will take, where it will end, and the peak motor outputs
+ *
+ * @b Example:
+ * @code {.cpp}
+ * const lemlib::MotionPreview preview = lemlib::previewTurnTo(90_cDeg, 2_sec, {}, {}, odom.getPose());
+ * @endcode
+ */
+MotionPreview previewTurnTo(std::variant<Angle, units::V2Position> target, Time timeout, const TurnToParams& params,
+                            TurnToSettings settings, units::Pose start,
+                            const DrivetrainModel& model = drivetrain_model);
 } // namespace lemlib
\ No newline at end of file
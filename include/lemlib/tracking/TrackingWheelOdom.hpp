@@ -3,6 +3,7 @@
 #include "hardware/Encoder/Encoder.hpp"
 #include "hardware/Port.hpp"
 #include "hardware/IMU/IMU.hpp"
+#include "lemlib/Scheduler.hpp"
 #include "pros/rtos.hpp"
 #include "units/Pose.hpp"
 #include <vector>
@@ -310,6 +311,34 @@ class TrackingWheelOdometry {
          * @endcode
          */
         void setPose(units::Pose pose);
+        /**
+         * @brief Get the event which is published every time the estimated pose is updated
+         *
+         * Motions can use this event as their trigger, so every iteration uses a pose that has just been calculated,
+         * instead of a pose that could be up to one period old.
+         *
+         * @return Event& the pose update event
+         *
+         * @b Example:
+         * @code {.cpp}
+         * // create TrackingWheelOdom object
+         * lemlib::TrackingWheelOdom odom(...);
+         *
+         * void autonomous() {
+         *   // iterate the motion every time the pose is updated
+         *   lemlib::turnTo(90_cDeg, 2_sec, {}, {.trigger = &odom.getPoseEvent()});
+         * }
+         * @endcode
+         *
+         * @b Example:
+         * @code {.cpp}
+         * // create TrackingWheelOdom object
+         * lemlib::TrackingWheelOdom odom(...);
+         * // make every motion iterate when the pose is updated by default
+         * lemlib::Event* const motion_trigger = &odom.getPoseEvent();
+         * @endcode
+         */
+        Event& getPoseEvent();
         /**
          * @brief start the tracking task. Sensors need to be calibrated beforehand
          *
@@ -351,7 +380,37 @@ class TrackingWheelOdometry {
          */
         void startTask(Time period = 10_msec);
         /**
-         * @brief Destroy the Tracking Wheel Odometry object. Stops the tracking task
+         * @brief run the tracking as a job of a scheduler. Sensors need to be calibrated beforehand
+         *
+         * Instead of creating its own task, the odometry is updated by the scheduler. Jobs added to the scheduler
+         * after the odometry with the same period always run after the odometry has updated, in the same tick.
+         * Nothing happens if the tracking has already been started. The scheduler must outlive the odometry, since
+         * the job is removed from it when the odometry is destroyed.
+         *
+         * @param scheduler the scheduler to run the tracking on
+         * @param period how often to update the pose. Defaults to 10 ms
+         *
+         * @b Example:
+         * @code {.cpp}
+         * // create TrackingWheelOdom object
+         * lemlib::TrackingWheelOdom odom(...);
+         * // create a scheduler
+         * lemlib::Scheduler scheduler;
+         *
+         * void initialize() {
+         *   // calibrate sensors
+         *   imu.calibrate();
+         *   // update the odometry every 10 ms from the scheduler
+         *   odom.startTask(scheduler, 10_msec);
+         *   scheduler.start();
+         *   // now we can get position data
+         * }
+         * @endcode
+         */
+        void startTask(Scheduler& scheduler, Time period = 10_msec);
+        /**
+         * @brief Destroy the Tracking Wheel Odometry object. Stops the tracking task, or removes the tracking job from
+         * the scheduler
          *
          * De-allocation of IMU pointers is up to the caller.
          */
@@ -360,12 +419,24 @@ class TrackingWheelOdometry {
         /**
          * @brief update the estimated pose
          *
+         * @return true the pose has been updated
+         * @return false there are not enough sensors to update the pose
+         */
+        bool update();
+        /**
+         * @brief update the estimated pose periodically
+         *
          * This function should have its own dedicated task
          */
-        void update(Time period);
+        void loop(Time period);
+        bool m_started = false;
+        bool m_failed = false;
         units::Pose m_pose = {0_m, 0_m, 0_cDeg};
+        Event m_poseEvent;
         Angle m_offset = 0_stDeg;
         std::optional<pros::Task> m_task = std::nullopt;
+        Scheduler* m_scheduler = nullptr;
+        std::optional<int> m_jobId = std::nullopt;
         std::vector<IMU*> m_Imus;
         std::vector<TrackingWheel*> m_verticalWheels;
         std::vector<TrackingWheel*> m_horizontalWheels;
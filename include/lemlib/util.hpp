@@ -1,6 +1,7 @@
 #pragma once
 
 #include "units/Pose.hpp"
+#include <optional>
 
 namespace lemlib {
 /**
@@ -55,6 +56,73 @@ enum class SlewDirection { INCREASING, DECREASING, ALL };
 Number slew(Number target, Number current, Number maxChangeRate, Time deltaTime,
             SlewDirection restrictDirection = SlewDirection::ALL);
 
+/**
+ * @class SCurveSlew
+ *
+ * @brief Constrain the change in a value over time, limiting both its rate of change and how quickly that rate
+ * changes
+ *
+ * slew() limits the rate of change, but the rate can still jump from 0 to its maximum in a single iteration, which is
+ * enough to make wheels slip or a tall robot tip. This limiter also limits the jerk, so the rate ramps up and down
+ * smoothly, and the value follows an S-curve. The rate is slowed down before the value reaches the target, so it does
+ * not overshoot a target which doesn't move.
+ *
+ * The limiter keeps track of the rate of change between updates, so one limiter should be used per value.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // change by up to 4 per second, and change that rate by up to 20 per second squared
+ * lemlib::SCurveSlew limiter(4, 20);
+ * Number power = 0;
+ * while (true) {
+ *   power = limiter.update(pid.update(error), power, 10_msec);
+ *   pros::delay(10);
+ * }
+ * @endcode
+ */
+class SCurveSlew {
+    public:
+        /**
+         * @brief Construct a new S-curve slew limiter
+         *
+         * @param maxRate the maximum rate of change. 0 disables the limiter, like slew()
+         * @param maxJerk the maximum change of the rate per second. 0 only limits the rate, like slew()
+         * @param restrictDirection in which direction to restrict the change. All directions by default
+         */
+        SCurveSlew(Number maxRate, Number maxJerk, SlewDirection restrictDirection = SlewDirection::ALL);
+        /**
+         * @brief Constrain the change in a value
+         *
+         * @param target the requested new value of the changing value
+         * @param current the value to be constrained
+         * @param deltaTime the change in time since the last update
+         * @return Number the value with the constrained change
+         */
+        Number update(Number target, Number current, Time deltaTime);
+        /**
+         * @brief Set the limits of the limiter, keeping its current rate of change
+         *
+         * @param maxRate the maximum rate of change
+         * @param maxJerk the maximum change of the rate per second
+         */
+        void setLimits(Number maxRate, Number maxJerk);
+        /**
+         * @brief Get the current rate of change
+         *
+         * @return Number the rate of change, per second
+         */
+        Number getRate() const;
+        /**
+         * @brief Forget the current rate of change, so the value starts changing from rest
+         */
+        void reset();
+    private:
+        Number m_maxRate;
+        Number m_maxJerk;
+        SlewDirection m_direction;
+        Number m_rate = 0;
+};
+
 /**
  * @brief Constrain a value so it's absolute value is greater than some value but less than some other value
  *
@@ -14,6 +14,14 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+// define M_PI_2 and M_TWOPI if not already defined. newlib defines them, but glibc doesn't define M_TWOPI
+#ifndef M_PI_2
+#define M_PI_2 1.57079632679489661923
+#endif
+#ifndef M_TWOPI
+#define M_TWOPI 6.28318530717958647692
+#endif
+
 // define typenames
 
 /**
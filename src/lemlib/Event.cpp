@@ -0,0 +1,69 @@
+#include "lemlib/Event.hpp"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace lemlib {
+bool Event::subscribe() {
+    const pros::task_t task = pros::c::task_get_current();
+    std::lock_guard lock(m_mutex);
+    // check if the task is already subscribed
+    if (std::find(m_subscribers.begin(), m_subscribers.end(), task) != m_subscribers.end()) return true;
+    // find an empty slot
+    auto slot = std::find(m_subscribers.begin(), m_subscribers.end(), nullptr);
+    if (slot == m_subscribers.end()) return false;
+    *slot = task;
+    return true;
+}
+
+void Event::unsubscribe() {
+    const pros::task_t task = pros::c::task_get_current();
+    std::lock_guard lock(m_mutex);
+    std::replace(m_subscribers.begin(), m_subscribers.end(), task, pros::task_t(nullptr));
+}
+
+void Event::publish() {
+    std::lock_guard lock(m_mutex);
+    ++m_count;
+    for (pros::task_t task : m_subscribers) {
+        if (task != nullptr) pros::c::task_notify_ext(task, NOTIFY_BIT, pros::E_NOTIFY_ACTION_BITS, nullptr);
+    }
+}
+
+std::uint32_t Event::getCount() {
+    std::lock_guard lock(m_mutex);
+    return m_count;
+}
+
+bool waitUntil(std::function<bool(void)> condition, Event& event, Time timeout) {
+    // subscribe before checking the condition, so a publish between the check and the wait isn't missed
+    if (!event.subscribe()) return condition();
+    if (condition()) {
+        event.unsubscribe();
+        return true;
+    }
+    const std::uint32_t start = pros::millis();
+    const bool forever = !std::isfinite(to_msec(timeout));
+    bool met = false;
+    while (true) {
+        // calculate how long to wait for
+        const std::uint32_t elapsed = pros::millis() - start;
+        if (!forever && elapsed >= to_msec(timeout)) break;
+        const std::uint32_t remaining = forever ? TIMEOUT_MAX : std::uint32_t(std::ceil(to_msec(timeout))) - elapsed;
+        // wait for the event
+        const std::uint32_t notification = pros::Task::notify_take(true, remaining);
+        // if the task has been notified by something else, put the notification back and stop waiting
+        if ((notification & ~Event::NOTIFY_BIT) != 0) {
+            pros::c::task_notify_ext(pros::c::task_get_current(), notification & ~Event::NOTIFY_BIT,
+                                     pros::E_NOTIFY_ACTION_BITS, nullptr);
+            break;
+        }
+        if (condition()) {
+            met = true;
+            break;
+        }
+    }
+    event.unsubscribe();
+    return met;
+}
+} // namespace lemlib
@@ -0,0 +1,19 @@
+#include "lemlib/Feedforward.hpp"
+
+using namespace units;
+
+namespace lemlib {
+Feedforward::Feedforward(Number kS, Number kV, Number kA, Number kG)
+    : m_gains({kS, kV, kA, kG}) {}
+
+Feedforward::Feedforward(const FeedforwardGains& gains)
+    : m_gains(gains) {}
+
+FeedforwardGains Feedforward::getGains() const { return m_gains; }
+
+void Feedforward::setGains(FeedforwardGains gains) { m_gains = gains; }
+
+Number Feedforward::calculate(Number velocity, Number acceleration) const {
+    return m_gains.kS * sgn(velocity) + m_gains.kV * velocity + m_gains.kA * acceleration + m_gains.kG;
+}
+} // namespace lemlib
@@ -0,0 +1,106 @@
+#include "lemlib/LQR.hpp"
+#include "lemlib/util.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace units;
+
+namespace lemlib {
+UnicycleLQR::UnicycleLQR(const LQRTolerances& tolerances, LinearVelocity maxSpeed, Time period)
+    : m_q({1 / std::pow(to_m(tolerances.x), 2), 1 / std::pow(to_m(tolerances.y), 2),
+           1 / std::pow(to_stRad(tolerances.theta), 2)}),
+      m_r({1 / std::pow(to_mps(tolerances.linear), 2), 1 / std::pow(to_radps(tolerances.angular), 2)}),
+      m_dt(to_sec(period)),
+      m_maxSpeed(to_mps(maxSpeed)) {
+    for (size_t i = 0; i < GRID_SIZE; i++) {
+        // lateral error can't be corrected without moving, so the slowest grid point uses a small speed instead of 0
+        const double speed = std::max(m_maxSpeed * i / (GRID_SIZE - 1), to_mps(1_inps));
+        m_gains[i] = solve(speed);
+    }
+}
+
+UnicycleLQR::Gain UnicycleLQR::solve(double speed) const {
+    // discretized model, linearized around driving straight at the given speed
+    // states are x, y and theta errors, inputs are linear and angular velocity corrections
+    const double a[3][3] = {{1, 0, 0}, {0, 1, speed * m_dt}, {0, 0, 1}};
+    const double b[3][2] = {{m_dt, 0}, {0, 0}, {0, m_dt}};
+
+    double p[3][3] = {{m_q[0], 0, 0}, {0, m_q[1], 0}, {0, 0, m_q[2]}};
+    Gain k = {};
+    for (int iteration = 0; iteration < 5000; iteration++) {
+        // B^T P and B^T P A
+        double btp[2][3] = {};
+        for (int r = 0; r < 2; r++) {
+            for (int c = 0; c < 3; c++) {
+                for (int j = 0; j < 3; j++) btp[r][c] += b[j][r] * p[j][c];
+            }
+        }
+        double btpa[2][3] = {};
+        for (int r = 0; r < 2; r++) {
+            for (int c = 0; c < 3; c++) {
+                for (int j = 0; j < 3; j++) btpa[r][c] += btp[r][j] * a[j][c];
+            }
+        }
+        // R + B^T P B, and its inverse
+        double s[2][2] = {{m_r[0], 0}, {0, m_r[1]}};
+        for (int r = 0; r < 2; r++) {
+            for (int c = 0; c < 2; c++) {
+                for (int j = 0; j < 3; j++) s[r][c] += btp[r][j] * b[j][c];
+            }
+        }
+        const double det = s[0][0] * s[1][1] - s[0][1] * s[1][0];
+        const double sInv[2][2] = {{s[1][1] / det, -s[0][1] / det}, {-s[1][0] / det, s[0][0] / det}};
+        // K = (R + B^T P B)^-1 B^T P A
+        for (int r = 0; r < 2; r++) {
+            for (int c = 0; c < 3; c++) k[r][c] = sInv[r][0] * btpa[0][c] + sInv[r][1] * btpa[1][c];
+        }
+        // P = Q + A^T P A - (B^T P A)^T K
+        double next[3][3] = {};
+        double change = 0;
+        double size = 0;
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) {
+                double atpa = 0;
+                for (int i = 0; i < 3; i++) {
+                    for (int j = 0; j < 3; j++) atpa += a[i][r] * p[i][j] * a[j][c];
+                }
+                next[r][c] = (r == c ? m_q[r] : 0) + atpa - (btpa[0][r] * k[0][c] + btpa[1][r] * k[1][c]);
+                change = std::max(change, std::abs(next[r][c] - p[r][c]));
+                size = std::max(size, std::abs(next[r][c]));
+            }
+        }
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) p[r][c] = next[r][c];
+        }
+        if (change <= 1e-9 * size) break;
+    }
+    return k;
+}
+
+UnicycleOutput UnicycleLQR::calculate(Pose pose, Pose reference, LinearVelocity referenceLinear,
+                                      AngularVelocity referenceAngular) const {
+    // error in the frame of the robot
+    const double dx = to_m(reference.x - pose.x);
+    const double dy = to_m(reference.y - pose.y);
+    const double c = cos(pose.orientation).internal();
+    const double s = sin(pose.orientation).internal();
+    const double error[3] = {c * dx + s * dy, -s * dx + c * dy,
+                             to_stRad(angleError(reference.orientation, pose.orientation))};
+
+    // interpolate the gains for the reference speed
+    const double position =
+        std::clamp(to_mps(referenceLinear) / m_maxSpeed, 0.0, 1.0) * (GRID_SIZE - 1);
+    const size_t lower = std::min(size_t(position), GRID_SIZE - 2);
+    const double t = position - lower;
+    double correction[2] = {};
+    for (int r = 0; r < 2; r++) {
+        for (int j = 0; j < 3; j++) {
+            const double gain = m_gains[lower][r][j] * (1 - t) + m_gains[lower + 1][r][j] * t;
+            correction[r] += gain * error[j];
+        }
+    }
+
+    return {referenceLinear * std::cos(error[2]) + from_mps(correction[0]),
+            referenceAngular + from_radps(correction[1])};
+}
+} // namespace lemlib
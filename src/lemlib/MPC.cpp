@@ -0,0 +1,161 @@
+#include "lemlib/MPC.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace units;
+
+namespace lemlib {
+/** how much more the last step of the plan is weighed than the others */
+constexpr double TERMINAL_WEIGHT = 10;
+
+PoseMPC::PoseMPC(const MPCConstraints& constraints, const MPCTolerances& tolerances, Time step, int iterations)
+    : m_constraints(constraints),
+      m_q({1 / std::pow(to_m(tolerances.longitudinal), 2), 1 / std::pow(to_m(tolerances.lateral), 2),
+           1 / std::pow(to_stRad(tolerances.heading), 2)}),
+      m_r(1 / std::pow(to_radps(tolerances.angular), 2)),
+      m_minInput({-to_mps(constraints.maxReverse), -to_radps(constraints.maxAngular)}),
+      m_maxInput({to_mps(constraints.maxLinear), to_radps(constraints.maxAngular)}),
+      m_maxDelta({to_mps2(constraints.maxLinearAcceleration) * to_sec(step),
+                  to_radps2(constraints.maxAngularAcceleration) * to_sec(step)}),
+      m_dt(to_sec(step)),
+      m_iterations(iterations) {}
+
+void PoseMPC::reset() { m_plan = {}; }
+
+const MPCConstraints& PoseMPC::getConstraints() const { return m_constraints; }
+
+void PoseMPC::integrate(const Input& current, const std::array<Input, HORIZON>& deltas,
+                        std::array<Input, HORIZON>& inputs,
+                        std::array<std::array<int, 2>, HORIZON>& saturated) const {
+    for (size_t k = 0; k < HORIZON; k++) {
+        for (int i = 0; i < 2; i++) {
+            const double previous = k == 0 ? current[i] : inputs[k - 1][i];
+            const double unclamped = previous + deltas[k][i];
+            inputs[k][i] = std::clamp(unclamped, m_minInput[i], m_maxInput[i]);
+            saturated[k][i] = unclamped > m_maxInput[i] ? 1 : unclamped < m_minInput[i] ? -1 : 0;
+        }
+    }
+}
+
+double PoseMPC::evaluate(const std::array<double, 3>& start, const Input& current,
+                         const std::array<Input, HORIZON>& deltas, std::array<Input, HORIZON>& gradient) const {
+    std::array<Input, HORIZON> inputs;
+    std::array<std::array<int, 2>, HORIZON> saturated;
+    integrate(current, deltas, inputs, saturated);
+
+    // simulate the unicycle model. Each state is x, y and theta, relative to the target
+    std::array<std::array<double, 3>, HORIZON + 1> states;
+    states[0] = start;
+    double cost = 0;
+    for (size_t k = 0; k < HORIZON; k++) {
+        const auto& [x, y, theta] = states[k];
+        const auto& [v, omega] = inputs[k];
+        states[k + 1] = {x + v * std::cos(theta) * m_dt, y + v * std::sin(theta) * m_dt, theta + omega * m_dt};
+        const double weight = k + 1 == HORIZON ? TERMINAL_WEIGHT : 1;
+        const auto& [nx, ny, ntheta] = states[k + 1];
+        // the heading cost is 2 - 2cos(theta), which is theta^2 for small errors but doesn't care about full turns
+        cost += weight * (m_q[0] * nx * nx + m_q[1] * ny * ny + m_q[2] * 2 * (1 - std::cos(ntheta)));
+        cost += m_r * omega * omega;
+    }
+
+    // propagate the gradient backwards through the model, then through the velocity limits
+    std::array<double, 3> costate = {};
+    Input total = {};
+    for (size_t step = HORIZON; step > 0; step--) {
+        const size_t k = step - 1;
+        // gradient of the cost of state k + 1
+        const auto& [nx, ny, ntheta] = states[k + 1];
+        const double weight = k + 1 == HORIZON ? TERMINAL_WEIGHT : 1;
+        costate[0] += weight * 2 * m_q[0] * nx;
+        costate[1] += weight * 2 * m_q[1] * ny;
+        costate[2] += weight * 2 * m_q[2] * std::sin(ntheta);
+
+        const double theta = states[k][2];
+        const auto& [v, omega] = inputs[k];
+        // gradient with respect to the inputs of step k, adding what later inputs depend on them. A velocity at its
+        // limit only passes on gradients which would move it away from the limit
+        const auto blocked = [&](size_t step, int i) {
+            return (saturated[step][i] > 0 && total[i] < 0) || (saturated[step][i] < 0 && total[i] > 0);
+        };
+        for (int i = 0; i < 2; i++) {
+            if (k + 1 < HORIZON && blocked(k + 1, i)) total[i] = 0;
+        }
+        total[0] += (costate[0] * std::cos(theta) + costate[1] * std::sin(theta)) * m_dt;
+        total[1] += costate[2] * m_dt + 2 * m_r * omega;
+        for (int i = 0; i < 2; i++) gradient[k][i] = blocked(k, i) ? 0 : total[i];
+
+        // gradient with respect to state k
+        costate[2] += (-costate[0] * std::sin(theta) + costate[1] * std::cos(theta)) * v * m_dt;
+    }
+    return cost;
+}
+
+MPCSolution PoseMPC::solve(Pose pose, Pose target, UnicycleOutput current) {
+    // the pose of the robot in the frame of the target
+    const double dx = to_m(pose.x - target.x);
+    const double dy = to_m(pose.y - target.y);
+    const double c = cos(target.orientation).internal();
+    const double s = sin(target.orientation).internal();
+    const std::array<double, 3> start = {c * dx + s * dy, -s * dx + c * dy,
+                                         std::remainder(to_stRad(pose.orientation - target.orientation), 2 * M_PI)};
+    const Input now = {to_mps(current.linear), to_radps(current.angular)};
+
+    // spectral projected gradient descent, starting from the previous plan
+    std::array<Input, HORIZON> plan = m_plan;
+    std::array<Input, HORIZON> gradient;
+    double cost = evaluate(start, now, plan, gradient);
+    std::array<Input, HORIZON> best = plan;
+    double bestCost = cost;
+    // the first step is scaled so the largest change is a tenth of the acceleration limit
+    double stepSize = [&] {
+        double largest = 0;
+        for (const Input& g : gradient) largest = std::max({largest, std::abs(g[0]) / m_maxDelta[0],
+                                                            std::abs(g[1]) / m_maxDelta[1]});
+        return largest == 0 ? 0 : 0.1 / largest;
+    }();
+    for (int iteration = 0; iteration < m_iterations && stepSize > 0; iteration++) {
+        std::array<Input, HORIZON> next;
+        for (size_t k = 0; k < HORIZON; k++) {
+            for (int i = 0; i < 2; i++) {
+                next[k][i] = std::clamp(plan[k][i] - stepSize * gradient[k][i], -m_maxDelta[i], m_maxDelta[i]);
+            }
+        }
+        // remove the part of each change the velocity limits cut off, so the plan can't wind up past them
+        {
+            std::array<Input, HORIZON> inputs;
+            std::array<std::array<int, 2>, HORIZON> saturated;
+            integrate(now, next, inputs, saturated);
+            for (size_t k = 0; k < HORIZON; k++) {
+                for (int i = 0; i < 2; i++) next[k][i] = inputs[k][i] - (k == 0 ? now[i] : inputs[k - 1][i]);
+            }
+        }
+        std::array<Input, HORIZON> nextGradient;
+        const double nextCost = evaluate(start, now, next, nextGradient);
+        if (nextCost < bestCost) {
+            best = next;
+            bestCost = nextCost;
+        }
+        // Barzilai-Borwein step size, from how much the gradient changed
+        double ss = 0;
+        double sy = 0;
+        for (size_t k = 0; k < HORIZON; k++) {
+            for (int i = 0; i < 2; i++) {
+                const double ds = next[k][i] - plan[k][i];
+                ss += ds * ds;
+                sy += ds * (nextGradient[k][i] - gradient[k][i]);
+            }
+        }
+        if (ss == 0) break;
+        // if the cost is not convex along the step, keep the previous step size
+        if (sy > 0) stepSize = ss / sy;
+        plan = next;
+        gradient = nextGradient;
+    }
+
+    m_plan = best;
+    std::array<Input, HORIZON> inputs;
+    std::array<std::array<int, 2>, HORIZON> saturated;
+    integrate(now, best, inputs, saturated);
+    return {{from_mps(inputs[0][0]), from_radps(inputs[0][1])}, bestCost};
+}
+} // namespace lemlib
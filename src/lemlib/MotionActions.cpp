@@ -0,0 +1,105 @@
+#include "lemlib/MotionActions.hpp"
+#include "LemLog/logger/Helper.hpp"
+#include "lemlib/util.hpp"
+#include <algorithm>
+
+using namespace units;
+
+namespace lemlib {
+
+static logger::Helper logHelper("lemlib/MotionActions");
+
+MotionAction::MotionAction(std::function<bool(const MotionProgress&)> condition, std::function<void(void)> callback)
+    : m_condition(std::move(condition)),
+      m_callback(std::move(callback)) {}
+
+MotionAction MotionAction::when(std::function<bool(const MotionProgress&)> condition,
+                                std::function<void(void)> callback) {
+    return {std::move(condition), std::move(callback)};
+}
+
+MotionAction MotionAction::atDistance(Length distance, std::function<void(void)> callback) {
+    return {[=](const MotionProgress& progress) { return progress.distanceTraveled >= distance; },
+            std::move(callback)};
+}
+
+MotionAction MotionAction::atFraction(Number fraction, std::function<void(void)> callback) {
+    return {[=](const MotionProgress& progress) { return progress.fraction >= fraction; }, std::move(callback)};
+}
+
+MotionAction MotionAction::beforeEnd(Time time, std::function<void(void)> callback) {
+    return {[=](const MotionProgress& progress) { return progress.timeRemaining <= time; }, std::move(callback)};
+}
+
+MotionAction MotionAction::atAngularError(AngleRange error, std::function<void(void)> callback) {
+    return {[=](const MotionProgress& progress) { return abs(progress.angularError) < error; }, std::move(callback)};
+}
+
+MotionAction MotionAction::afterTime(Time time, std::function<void(void)> callback) {
+    return {[=](const MotionProgress& progress) { return progress.elapsed >= time; }, std::move(callback)};
+}
+
+bool MotionAction::update(const MotionProgress& progress) const {
+    if (!m_condition(progress)) return false;
+    m_callback();
+    return true;
+}
+
+ActionRunner::ActionRunner(const std::vector<MotionAction>& actions)
+    : m_actions(actions) {
+    if (m_actions.size() > MAX_ACTIONS) {
+        logHelper.error("Motion has {} actions, but only the first {} will run", m_actions.size(), MAX_ACTIONS);
+    }
+}
+
+void ActionRunner::update(const MotionProgress& progress) {
+    for (std::size_t i = 0; i < std::min(m_actions.size(), MAX_ACTIONS); ++i) {
+        if (!m_done[i]) m_done[i] = m_actions[i].update(progress);
+    }
+}
+
+ProgressTracker::ProgressTracker(Pose start)
+    : m_lastPose(start) {}
+
+void ProgressTracker::update(Pose pose, Time delta) {
+    const Length distance = m_lastPose.distanceTo(pose);
+    // unwrapped, so a pose source which wraps its heading doesn't add a full turn of progress at every wrap
+    const Angle angle = abs(angleError(pose.orientation, m_lastPose.orientation));
+    m_lastPose = pose;
+    m_elapsed += delta;
+    m_distance += distance;
+    m_angleTraveled += angle;
+    // low pass filter the speeds, since the pose is noisy over a single iteration
+    if (delta > 0_sec) {
+        m_linearSpeed = 0.7 * m_linearSpeed + 0.3 * (distance / delta);
+        m_angularSpeed = 0.7 * m_angularSpeed + 0.3 * (angle / delta);
+    }
+}
+
+MotionProgress ProgressTracker::getLinearProgress(Length remaining, Length lateralError, Angle angularError) {
+    remaining = abs(remaining);
+    const Length total = m_distance + remaining;
+    return {.elapsed = m_elapsed,
+            .distanceTraveled = m_distance,
+            .fraction = total > 0_in ? Number(m_distance / total) : Number(1),
+            .timeRemaining = m_linearSpeed > 0_mps ? remaining / m_linearSpeed : Time(INFINITY),
+            .lateralError = lateralError,
+            .angularError = angularError};
+}
+
+MotionProgress ProgressTracker::getAngularProgress(Angle angularError) {
+    const Angle remaining = abs(angularError);
+    const Angle total = m_angleTraveled + remaining;
+    return {.elapsed = m_elapsed,
+            .distanceTraveled = m_distance,
+            .fraction = total > 0_stRad ? Number(m_angleTraveled / total) : Number(1),
+            .timeRemaining = m_angularSpeed > 0_radps ? remaining / m_angularSpeed : Time(INFINITY),
+            .lateralError = 0_in,
+            .angularError = angularError};
+}
+
+LinearVelocity ProgressTracker::getLinearSpeed() const { return m_linearSpeed; }
+
+AngularVelocity ProgressTracker::getAngularSpeed() const { return m_angularSpeed; }
+
+} // namespace lemlib
@@ -1,33 +1,101 @@
 #include "lemlib/MotionCancelHelper.hpp"
+#include "lemlib/MotionHandler.hpp"
+#include "LemLog/logger/Helper.hpp"
 #include "pros/rtos.hpp"
 #include "pros/misc.h"
 
 namespace lemlib {
-MotionCancelHelper::MotionCancelHelper(Time period)
+
+static logger::Helper logHelper("lemlib/MotionCancelHelper");
+
+MotionCancelHelper::MotionCancelHelper(Time period, Event* trigger)
     : m_originalCompStatus(pros::c::competition_get_status()),
       m_prevTime(pros::millis() - to_msec(period)),
-      m_prevPrevTime(pros::millis() - to_msec(period)),
-      m_period(period) {}
+      m_timestamp(pros::micros() - std::uint64_t(to_usec(period))),
+      m_prevTimestamp(m_timestamp),
+      m_period(period),
+      m_trigger(trigger) {
+    if (m_trigger != nullptr && !m_trigger->subscribe()) {
+        // without a subscription the trigger would never wake the motion, so fall back to the fixed period
+        logHelper.error("Failed to subscribe to the motion trigger, too many tasks are subscribed to it. Iterating "
+                        "every {} instead",
+                        period);
+        m_trigger = nullptr;
+    }
+}
 
 bool MotionCancelHelper::wait() {
-    m_prevPrevTime = from_msec(m_prevTime);
+    m_prevTimestamp = m_timestamp;
     const std::uint32_t processedTimeout = to_msec(m_period);
-    // if current time - previous time > timeout
-    // then set previous time to current time
-    // this is to prevent the motion iterating multiple times
-    // with no delay in between
-    const int64_t now = int64_t(pros::millis());
-    if (now - int64_t(m_prevTime) > int64_t(processedTimeout)) m_prevTime = now - processedTimeout;
-    // only delay if this is not the first iteration
-    if (!m_firstIteration) pros::Task::delay_until(&m_prevTime, processedTimeout);
-    else m_firstIteration = false;
+    // the last iteration has finished, let tasks waiting on the motion check its progress
+    if (!m_firstIteration) motion_handler::getProgressEvent().publish();
+    if (m_trigger != nullptr) {
+        // wait until the trigger has been published, or the motion has been cancelled
+        // if the trigger isn't published for 2 periods, iterate anyway
+        if (!m_firstIteration) m_notification |= pros::Task::notify_take(true, 2 * processedTimeout);
+        else m_firstIteration = false;
+        m_prevTime = pros::millis();
+    } else {
+        // if current time - previous time > timeout
+        // then set previous time to current time
+        // this is to prevent the motion iterating multiple times
+        // with no delay in between
+        const int64_t now = int64_t(pros::millis());
+        if (now - int64_t(m_prevTime) > int64_t(processedTimeout)) m_prevTime = now - processedTimeout;
+        // only delay if this is not the first iteration
+        if (!m_firstIteration) {
+            // block until the next iteration is due, unless the task is notified in the meantime
+            // this way, a cancelled motion stops immediately instead of at the end of the period
+            const std::uint32_t wakeTime = m_prevTime + processedTimeout;
+            while (true) {
+                const int64_t remaining = int64_t(wakeTime) - int64_t(pros::millis());
+                if (remaining <= 0) break;
+                const std::uint32_t notification = pros::Task::notify_take(true, remaining);
+                m_notification |= notification;
+                // stop waiting if timed out, or if there was a notification other than an event being published
+                if ((notification & ~Event::NOTIFY_BIT) != 0 || notification == 0) break;
+            }
+            m_prevTime = wakeTime;
+        } else {
+            m_firstIteration = false;
+            m_prevTime = now;
+        }
+    }
+
+    // the schedule above has millisecond resolution, but the timestamp of the iteration is read in microseconds
+    // so the time between iterations can be measured precisely
+    m_timestamp = pros::micros();
 
     // if the competition state is not the same as when the motion started, then stop the motion
     if (pros::c::competition_get_status() != m_originalCompStatus) return 0;
 
-    // check if there was a notification
-    return pros::Task::notify_take(true, 0) == 0;
+    // check if there was a notification, other than the trigger being published
+    m_notification |= pros::Task::notify_take(true, 0);
+    return (m_notification & ~Event::NOTIFY_BIT) == 0;
+}
+
+Time MotionCancelHelper::getDelta() { return from_usec(m_timestamp - m_prevTimestamp); }
+
+Time MotionCancelHelper::getTime() { return from_usec(m_timestamp); }
+
+MotionCancelHelper::~MotionCancelHelper() {
+    if (m_trigger != nullptr) m_trigger->unsubscribe();
+}
+
+SubLoop::SubLoop(Time period, Time loopPeriod)
+    : m_period(period),
+      m_loopPeriod(loopPeriod) {}
+
+bool SubLoop::update(Time delta) {
+    m_elapsed += delta;
+    // always run on the first iteration
+    // afterwards, run when it is closer to run now than on the next iteration
+    if (!m_firstIteration && m_elapsed + m_loopPeriod / 2 < m_period) return false;
+    m_delta = m_firstIteration ? delta : m_elapsed;
+    m_elapsed = 0_sec;
+    m_firstIteration = false;
+    return true;
 }
 
-Time MotionCancelHelper::getDelta() { return from_msec(pros::millis()) - m_prevPrevTime; }
-} // namespace lemlib
\ No newline at end of file
+Time SubLoop::getDelta() { return m_delta; }
+} // namespace lemlib
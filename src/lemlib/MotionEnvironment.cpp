@@ -0,0 +1,30 @@
+#include "lemlib/MotionEnvironment.hpp"
+#include "lemlib/config.hpp"
+
+namespace lemlib {
+RobotEnvironment::RobotEnvironment(Time period, Event* trigger, Time timeout, const PoseSource& poseSource,
+                                   MotorGroup& leftMotors, MotorGroup& rightMotors)
+    : m_helper(period, trigger),
+      m_timer(timeout),
+      m_poseSource(poseSource),
+      m_leftMotors(leftMotors, voltage_compensation),
+      m_rightMotors(rightMotors, voltage_compensation) {}
+
+bool RobotEnvironment::wait() { return m_helper.wait(); }
+
+Time RobotEnvironment::getDelta() { return m_helper.getDelta(); }
+
+Time RobotEnvironment::getTime() { return m_helper.getTime(); }
+
+bool RobotEnvironment::isDone() { return m_timer.isDone(); }
+
+units::Pose RobotEnvironment::getPose() { return m_poseSource(); }
+
+CompensatedMotors& RobotEnvironment::getLeftMotors() { return m_leftMotors; }
+
+CompensatedMotors& RobotEnvironment::getRightMotors() { return m_rightMotors; }
+
+void RobotEnvironment::updateActions(ActionRunner& actions, const MotionProgress& progress) {
+    actions.update(progress);
+}
+} // namespace lemlib
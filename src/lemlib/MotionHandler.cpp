@@ -1,30 +1,162 @@
 #include "lemlib/MotionHandler.hpp"
+#include "LemLog/logger/Helper.hpp"
+#include "lemlib/config.hpp"
 #include "pros/rtos.hpp"
+#include <array>
+#include <mutex>
+#include <optional>
 
 namespace lemlib::motion_handler {
-// initialize tasks
-static std::optional<pros::Task> motionTask = std::nullopt;
-
-void move(std::function<void(void)> f) {
-    // wait until there is no motion running
-    while (isMoving()) pros::delay(5);
-    // start the new motion
-    motionTask = pros::Task([=] {
-        // only start the motion if it hasn't been cancelled yet
-        if (pros::Task::notify_take(true, 0) == 0) f();
-    });
+
+static logger::Helper logHelper("lemlib/motion_handler");
+
+static Event progressEvent;
+
+/**
+ * @brief the state of a single motion channel
+ *
+ * The queue is a ring buffer protected by the mutex. The worker task waits for a notification while it is idle.
+ * While a motion is running, a notification means the motion has been cancelled, so motions are only queued with a
+ * notification if the worker is idle.
+ */
+struct ChannelState {
+        pros::Mutex mutex;
+        std::optional<pros::Task> worker = std::nullopt;
+        std::array<std::function<void(void)>, MAX_QUEUED_MOTIONS> queue;
+        std::uint8_t head = 0;
+        std::uint8_t size = 0;
+        bool running = false;
+        std::optional<std::uint64_t> cancelTime = std::nullopt;
+        CancelStats cancelStats;
+};
+
+static std::array<ChannelState, MAX_CHANNELS> channels;
+
+/**
+ * @brief run motions queued on a channel, forever
+ *
+ * @param state the channel to serve
+ */
+static void serveChannel(ChannelState& state) {
+    while (true) {
+        std::function<void(void)> f;
+        {
+            std::lock_guard lock(state.mutex);
+            if (state.size != 0) {
+                f = std::move(state.queue.at(state.head));
+                state.head = (state.head + 1) % MAX_QUEUED_MOTIONS;
+                --state.size;
+                state.running = true;
+                state.cancelTime = std::nullopt;
+                // clear notifications sent while the worker was idle, so they don't cancel the new motion
+                pros::Task::notify_take(true, 0);
+            } else {
+                state.running = false;
+            }
+        }
+        // wait until a motion is queued
+        if (!f) {
+            pros::Task::notify_take(true, TIMEOUT_MAX);
+            continue;
+        }
+        f();
+        {
+            std::lock_guard lock(state.mutex);
+            state.running = false;
+            // the motion consumes the cancel notification when it sees it. If the notification is still pending, the
+            // motion finished on its own before it noticed the cancellation, so it doesn't count as cancelled
+            const bool cancelPending = (pros::Task::notify_take(true, 0) & ~Event::NOTIFY_BIT) != 0;
+            if (state.cancelTime && cancelPending) {
+                state.cancelTime = std::nullopt;
+                if (log_level <= logger::Level::DEBUG) logHelper.debug("Motion finished before it was cancelled");
+            }
+            // record how long it took for the motion to stop after it was cancelled
+            if (state.cancelTime) {
+                const Time latency = from_usec(pros::micros() - *state.cancelTime);
+                state.cancelTime = std::nullopt;
+                state.cancelStats.lastLatency = latency;
+                state.cancelStats.maxLatency = units::max(state.cancelStats.maxLatency, latency);
+                ++state.cancelStats.cancellations;
+                if (log_level <= logger::Level::DEBUG) {
+                    logHelper.debug("Motion stopped {:.2f} ms after being cancelled", to_msec(latency));
+                }
+            }
+        }
+        // let tasks waiting for the motion to end know it has ended
+        progressEvent.publish();
+    }
+}
+
+/**
+ * @brief get the state of a channel
+ *
+ * @param channel the channel
+ *
+ * @return ChannelState* the state of the channel, or nullptr if the channel id is out of range
+ */
+static ChannelState* getChannel(Channel channel) {
+    if (channel.id >= MAX_CHANNELS) {
+        logHelper.error("Motion channel {} does not exist! Channel ids must be less than {}", channel.id,
+                        MAX_CHANNELS);
+        return nullptr;
+    }
+    return &channels.at(channel.id);
 }
 
-bool isMoving() {
-    // check if the task exists
-    if (motionTask == std::nullopt) return false;
-    // check if the task is currently running
-    const std::uint32_t state = motionTask->get_state();
-    return state != pros::E_TASK_STATE_DELETED && state != pros::E_TASK_STATE_INVALID;
+void move(std::function<void(void)> f, Channel channel) {
+    ChannelState* state = getChannel(channel);
+    if (state == nullptr) return;
+    // wait until there is space in the queue
+    while (true) {
+        {
+            std::lock_guard lock(state->mutex);
+            if (state->size < MAX_QUEUED_MOTIONS) {
+                state->queue.at((state->head + state->size) % MAX_QUEUED_MOTIONS) = std::move(f);
+                ++state->size;
+                // start the worker if it does not exist yet, otherwise wake it up if it is idle
+                if (state->worker == std::nullopt) {
+                    state->worker = pros::Task([state] { serveChannel(*state); }, "lemlib motion channel");
+                } else if (!state->running) state->worker->notify();
+                return;
+            }
+        }
+        pros::delay(5);
+    }
 }
 
-void cancel() {
-    // if the task is currently running, notify the task
-    if (isMoving()) motionTask->notify();
+bool isMoving(Channel channel) {
+    ChannelState* state = getChannel(channel);
+    if (state == nullptr) return false;
+    std::lock_guard lock(state->mutex);
+    return state->running || state->size != 0;
+}
+
+void cancel(Channel channel) {
+    ChannelState* state = getChannel(channel);
+    if (state == nullptr) return;
+    std::lock_guard lock(state->mutex);
+    // drop queued motions
+    for (; state->size != 0; --state->size) {
+        state->queue.at(state->head) = nullptr;
+        state->head = (state->head + 1) % MAX_QUEUED_MOTIONS;
+    }
+    // if a motion is currently running, notify the worker
+    if (state->running) {
+        if (!state->cancelTime) state->cancelTime = pros::micros();
+        state->worker->notify();
+    }
+}
+
+void cancelAll() {
+    for (std::uint8_t id = 0; id < MAX_CHANNELS; ++id) cancel(Channel {id});
+}
+
+Event& getProgressEvent() { return progressEvent; }
+
+CancelStats getCancelStats(Channel channel) {
+    ChannelState* state = getChannel(channel);
+    if (state == nullptr) return {};
+    std::lock_guard lock(state->mutex);
+    return state->cancelStats;
 }
-} // namespace lemlib::motion_handler
\ No newline at end of file
+} // namespace lemlib::motion_handler
@@ -0,0 +1,88 @@
+#include "lemlib/MotionProfile.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace units;
+
+namespace lemlib {
+MotionProfile::MotionProfile(Number distance, Number maxVelocity, Number maxAcceleration, Number maxJerk)
+    : m_sign(distance < 0 ? -1 : 1) {
+    const double totalDistance = std::abs(distance.internal());
+    const double a = maxAcceleration.internal();
+    const double j = maxJerk.internal();
+    if (totalDistance == 0 || maxVelocity <= 0 || a <= 0) return;
+
+    // how long the jerk and constant acceleration phases take to reach a velocity from rest
+    struct Ramp {
+            double jerkTime;
+            double accelerationTime;
+    };
+
+    const auto ramp = [&](double velocity) -> Ramp {
+        if (j <= 0) return {0, velocity / a};
+        // the max acceleration is never reached, so the acceleration ramps up then straight back down
+        if (velocity * j < a * a) return {std::sqrt(velocity / j), 0};
+        return {a / j, velocity / a - a / j};
+    };
+    // the acceleration is symmetric, so the average velocity while accelerating is half the peak
+    const auto rampDistance = [&](double velocity) {
+        const Ramp r = ramp(velocity);
+        return velocity * (2 * r.jerkTime + r.accelerationTime) / 2;
+    };
+
+    // if the max velocity can't be reached, find the highest velocity which can
+    double peak = maxVelocity.internal();
+    if (2 * rampDistance(peak) > totalDistance) {
+        double low = 0;
+        double high = peak;
+        for (int i = 0; i < 50; i++) {
+            peak = (low + high) / 2;
+            if (2 * rampDistance(peak) > totalDistance) high = peak;
+            else low = peak;
+        }
+        peak = low;
+    }
+    const Ramp r = ramp(peak);
+    const double peakAcceleration = j <= 0 ? a : std::min(a, j * r.jerkTime);
+    const double cruiseTime = peak > 0 ? (totalDistance - 2 * rampDistance(peak)) / peak : 0;
+
+    // the acceleration of each phase is set explicitly, since it jumps between phases without a jerk limit
+    const double jerk = j <= 0 ? 0 : j;
+    m_segments = {{{r.jerkTime, jerk, 0, 0, 0},
+                   {r.accelerationTime, 0, 0, 0, peakAcceleration},
+                   {r.jerkTime, -jerk, 0, 0, j <= 0 ? 0 : peakAcceleration},
+                   {cruiseTime, 0, 0, 0, 0},
+                   {r.jerkTime, -jerk, 0, 0, 0},
+                   {r.accelerationTime, 0, 0, 0, -peakAcceleration},
+                   {r.jerkTime, jerk, 0, 0, j <= 0 ? 0 : -peakAcceleration}}};
+    // integrate the position and velocity at the start of each phase
+    for (size_t i = 1; i < m_segments.size(); i++) {
+        const Segment& prev = m_segments[i - 1];
+        const double t = prev.duration;
+        m_segments[i].position = prev.position + prev.velocity * t + prev.acceleration * t * t / 2 +
+                                 prev.jerk * t * t * t / 6;
+        m_segments[i].velocity = prev.velocity + prev.acceleration * t + prev.jerk * t * t / 2;
+    }
+    for (const Segment& segment : m_segments) m_duration += segment.duration;
+}
+
+ProfileState MotionProfile::sample(Time time) const {
+    double t = std::clamp(to_sec(time), 0.0, m_duration);
+    for (const Segment& segment : m_segments) {
+        if (t > segment.duration && &segment != &m_segments.back()) {
+            t -= segment.duration;
+            continue;
+        }
+        const double position = segment.position + segment.velocity * t + segment.acceleration * t * t / 2 +
+                                segment.jerk * t * t * t / 6;
+        const double velocity = segment.velocity + segment.acceleration * t + segment.jerk * t * t / 2;
+        const double acceleration = segment.acceleration + segment.jerk * t;
+        // the profile has ended
+        if (to_sec(time) >= m_duration) return {m_sign * position, 0, 0};
+        return {m_sign * position, m_sign * velocity, m_sign * acceleration};
+    }
+    return {};
+}
+
+Time MotionProfile::getDuration() const { return from_sec(m_duration); }
+} // namespace lemlib
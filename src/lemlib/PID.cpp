@@ -5,6 +5,31 @@ namespace lemlib {
 
 using namespace units;
 
+GainSchedule::GainSchedule(std::initializer_list<GainPoint> points, ScheduleVariable variable)
+    : m_variable(variable) {
+    for (const GainPoint& point : points) {
+        if (m_size == MAX_POINTS) break;
+        m_points[m_size++] = point;
+    }
+}
+
+Gains GainSchedule::interpolate(Number input) const {
+    if (m_size == 0) return {};
+    if (input <= m_points[0].input) return m_points[0].gains;
+    for (size_t i = 1; i < m_size; i++) {
+        const GainPoint& upper = m_points[i];
+        if (input > upper.input) continue;
+        const GainPoint& lower = m_points[i - 1];
+        const Number t = (input - lower.input) / (upper.input - lower.input);
+        return {lower.gains.kP + (upper.gains.kP - lower.gains.kP) * t,
+                lower.gains.kI + (upper.gains.kI - lower.gains.kI) * t,
+                lower.gains.kD + (upper.gains.kD - lower.gains.kD) * t};
+    }
+    return m_points[m_size - 1].gains;
+}
+
+ScheduleVariable GainSchedule::getVariable() const { return m_variable; }
+
 PID::PID(Number kP, Number kI, Number kD, Number windupRange, bool signFlipReset)
     : m_gains({kP, kI, kD}),
       m_windupRange(windupRange),
@@ -15,17 +40,48 @@ PID::PID(const Gains& gains, Number windupRange, bool signFlipReset)
       m_windupRange(windupRange),
       m_signFlipReset(signFlipReset) {}
 
+PID::PID(const GainSchedule& schedule, Number windupRange, bool signFlipReset)
+    : m_gains(schedule.interpolate(0)),
+      m_schedule(schedule),
+      m_windupRange(windupRange),
+      m_signFlipReset(signFlipReset) {}
+
 Gains PID::getGains() { return m_gains; }
 
 void PID::setGains(lemlib::Gains gains) { m_gains = gains; }
 
+void PID::setGainSchedule(std::optional<GainSchedule> schedule) { m_schedule = schedule; }
+
+const std::optional<GainSchedule>& PID::getGainSchedule() { return m_schedule; }
+
+void PID::schedule(Number input) {
+    // other schedules are applied by update()
+    if (!m_schedule || m_schedule->getVariable() != ScheduleVariable::EXTERNAL) return;
+    m_gains = m_schedule->interpolate(input);
+}
+
 Number PID::update(Number error) {
     // find time delta
-    const Time now = from_msec(pros::millis());
+    const Time now = from_usec(pros::micros());
     // if this is the first iteration, previousTime won't be set
     // if it is not set, then assume dt is 0
-    Time dt = (m_previousTime == std::nullopt) ? 0_msec : now - *m_previousTime;
+    const Time dt = (m_previousTime == std::nullopt) ? 0_msec : now - *m_previousTime;
     m_previousTime = now;
+    return update(error, dt);
+}
+
+Number PID::update(Number error, Time dt) {
+    // schedule the gains
+    if (m_schedule) {
+        const ScheduleVariable variable = m_schedule->getVariable();
+        if (variable == ScheduleVariable::ERROR || (variable == ScheduleVariable::INITIAL_ERROR && m_firstUpdate)) {
+            m_gains = m_schedule->interpolate(abs(error));
+        }
+    }
+
+    // on the first update since the controller was reset, there is no previous error to use
+    if (m_firstUpdate) dt = 0_sec;
+    m_firstUpdate = false;
 
     // calculate the derivative (change in error / time passed)
     const Number derivative = (dt != 0_sec) ? (error - m_previousError) / to_sec(dt) : 0;
@@ -45,6 +101,8 @@ Number PID::update(Number error) {
 void lemlib::PID::reset() {
     m_previousError = 0;
     m_integral = 0;
+    m_previousTime = std::nullopt;
+    m_firstUpdate = true;
 }
 
 void lemlib::PID::setSignFlipReset(bool signFlipReset) { m_signFlipReset = signFlipReset; }
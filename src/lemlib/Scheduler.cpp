@@ -0,0 +1,134 @@
+#include "lemlib/Scheduler.hpp"
+#include "LemLog/logger/Helper.hpp"
+#include <algorithm>
+#include <mutex>
+
+namespace lemlib {
+
+static logger::Helper logHelper("lemlib/scheduler");
+
+Scheduler::Scheduler(Time tick)
+    : m_tickMsec(std::max<std::uint32_t>(1, to_msec(tick))) {}
+
+int Scheduler::addJob(std::function<void(void)> job, Time period) {
+    std::lock_guard lock(m_mutex);
+    const std::uint32_t periodTicks = std::max<std::uint32_t>(1, std::round(to_msec(period) / m_tickMsec));
+    if (periodTicks * m_tickMsec != std::uint32_t(std::round(to_msec(period)))) {
+        logHelper.warn("Job period {} is not a multiple of the scheduler tick, running every {} ms instead", period,
+                       periodTicks * m_tickMsec);
+    }
+    const int id = m_nextId++;
+    // jobs are stored in a list so they don't move when other jobs are added, even while they are running
+    m_storage.push_back({id, std::move(job), periodTicks, {}});
+    Job* const added = &m_storage.back();
+    // rate monotonic order: shorter periods first. Jobs with equal periods keep the order they were added in
+    const auto position =
+        std::upper_bound(m_jobs.begin(), m_jobs.end(), periodTicks,
+                         [](std::uint32_t ticks, const Job* other) { return ticks < other->periodTicks; });
+    m_jobs.insert(position, added);
+    return id;
+}
+
+bool Scheduler::removeJob(int id) {
+    std::unique_lock lock(m_mutex);
+    const auto job = std::find_if(m_jobs.begin(), m_jobs.end(), [id](const Job* job) { return job->id == id; });
+    if (job == m_jobs.end()) return false;
+    Job* const removed = *job;
+    m_jobs.erase(job);
+    removed->removed = true;
+    // without the scheduler task, nothing else can be using the job
+    if (!m_task) {
+        m_storage.remove_if([](const Job& job) { return job.removed; });
+        return true;
+    }
+    // a job removing itself can't wait for itself to finish
+    if (pros::c::task_get_current() == pros::task_t(*m_task)) return true;
+    // wait for the job to finish, so whatever it uses can be destroyed
+    while (m_running == removed) {
+        lock.unlock();
+        pros::delay(1);
+        lock.lock();
+    }
+    return true;
+}
+
+void Scheduler::start() {
+    if (m_task == std::nullopt) {
+        m_task = pros::Task([this] { this->loop(); }, TASK_PRIORITY_DEFAULT + 1, TASK_STACK_DEPTH_DEFAULT,
+                            "lemlib scheduler");
+        logHelper.info("Scheduler started!");
+    } else {
+        logHelper.warn("Tried to start scheduler, but it has already been started!");
+    }
+}
+
+std::optional<JobStats> Scheduler::getStats(int id) {
+    std::lock_guard lock(m_mutex);
+    for (const Job* job : m_jobs) {
+        if (job->id == id) return job->stats;
+    }
+    return std::nullopt;
+}
+
+std::uint32_t Scheduler::getOverruns() {
+    std::lock_guard lock(m_mutex);
+    return m_overruns;
+}
+
+void Scheduler::loop() {
+    std::uint32_t prevTime = pros::millis();
+    std::uint32_t tick = 0;
+    // run until the task has been notified
+    while (pros::Task::notify_take(true, 0) == 0) {
+        const std::uint64_t tickStart = pros::micros();
+        // copy out the jobs which are due, so they run without holding the mutex and can add jobs themselves
+        {
+            std::lock_guard lock(m_mutex);
+            // no removed job is running or due, so they can be destroyed
+            m_storage.remove_if([](const Job& job) { return job.removed; });
+            // only allocates if jobs have been added since the last tick
+            m_due.reserve(m_jobs.size());
+            m_due.clear();
+            for (Job* job : m_jobs) {
+                if (tick % job->periodTicks == 0) m_due.push_back(job);
+            }
+        }
+        for (Job* job : m_due) {
+            {
+                // skip jobs removed by a job that ran earlier in this tick
+                std::lock_guard lock(m_mutex);
+                if (job->removed) continue;
+                m_running = job;
+            }
+            const std::uint64_t start = pros::micros();
+            job->function();
+            const Time executionTime = from_usec(pros::micros() - start);
+            std::lock_guard lock(m_mutex);
+            m_running = nullptr;
+            job->stats.lastExecutionTime = executionTime;
+            job->stats.maxExecutionTime = units::max(job->stats.maxExecutionTime, executionTime);
+            job->stats.totalExecutionTime += executionTime;
+            ++job->stats.executions;
+        }
+        if (pros::micros() - tickStart > m_tickMsec * 1000) {
+            std::lock_guard lock(m_mutex);
+            ++m_overruns;
+        }
+        ++tick;
+
+        // if the jobs took longer than a tick, don't try to catch up
+        // this is to prevent the jobs running multiple times with no delay in between
+        const std::uint32_t now = pros::millis();
+        if (now - prevTime > m_tickMsec) prevTime = now - m_tickMsec;
+        pros::Task::delay_until(&prevTime, m_tickMsec);
+    }
+    logHelper.info("Scheduler stopped!");
+}
+
+Scheduler::~Scheduler() {
+    if (!m_task) return;
+    // the task uses the jobs and the mutex, so wait for it to stop before they are destroyed
+    m_task->notify();
+    m_task->join();
+}
+} // namespace lemlib
@@ -0,0 +1,107 @@
+#include "lemlib/Simulation.hpp"
+#include "LemLog/logger/Helper.hpp"
+#include <cmath>
+
+using namespace units;
+
+namespace lemlib {
+
+static logger::Helper logHelper("lemlib/Simulation");
+
+SimulatedMotors::SimulatedMotors(const DrivetrainModel& model)
+    : m_model(model) {}
+
+int SimulatedMotors::move(Number percent) {
+    m_command = clamp(percent, Number(-1), Number(1));
+    m_peakOutput = max(m_peakOutput, abs(m_command));
+    return 0;
+}
+
+int SimulatedMotors::brake() {
+    m_command = 0;
+    return 0;
+}
+
+int SimulatedMotors::setBrakeMode(BrakeMode mode) {
+    m_brakeMode = mode;
+    return 0;
+}
+
+BrakeMode SimulatedMotors::getBrakeMode() { return m_brakeMode; }
+
+Angle SimulatedMotors::getAngle() { return from_stRad(to_in(m_distance) / to_in(m_model.wheelDiameter / 2)); }
+
+LinearVelocity SimulatedMotors::getVelocity() { return m_velocity; }
+
+Number SimulatedMotors::getPeakOutput() { return m_peakOutput; }
+
+void SimulatedMotors::step(Time dt) {
+    // first order response towards the commanded speed
+    const LinearVelocity target = m_command * m_model.maxSpeed;
+    m_velocity += (target - m_velocity) * (1 - std::exp(-to_sec(dt) / to_sec(m_model.timeConstant)));
+    m_distance += m_velocity * dt;
+}
+
+SimulatedEnvironment::SimulatedEnvironment(Pose start, Time period, Time timeout, const DrivetrainModel& model)
+    : m_model(model),
+      m_period(period),
+      m_timeout(timeout),
+      m_pose(start),
+      m_leftMotors(m_model),
+      m_rightMotors(m_model) {
+    // time only passes when the motion waits, so a motion with no period would never end
+    if (period <= 0_sec) logHelper.error("Can't preview a motion with a period of {}, it has to be positive", period);
+}
+
+bool SimulatedEnvironment::wait() {
+    if (m_period <= 0_sec) return false;
+    // time only passes between iterations
+    if (!m_firstIteration) step(m_period);
+    m_firstIteration = false;
+    return true;
+}
+
+Time SimulatedEnvironment::getDelta() { return m_period; }
+
+Time SimulatedEnvironment::getTime() { return m_time; }
+
+bool SimulatedEnvironment::isDone() { return m_time >= m_timeout; }
+
+Pose SimulatedEnvironment::getPose() { return m_pose; }
+
+SimulatedMotors& SimulatedEnvironment::getLeftMotors() { return m_leftMotors; }
+
+SimulatedMotors& SimulatedEnvironment::getRightMotors() { return m_rightMotors; }
+
+void SimulatedEnvironment::updateActions(ActionRunner&, const MotionProgress&) {}
+
+MotionPreview SimulatedEnvironment::finish() {
+    if (m_period <= 0_sec) return {};
+    MotionPreview preview {.duration = m_time,
+                           .peakLeftOutput = m_leftMotors.getPeakOutput(),
+                           .peakRightOutput = m_rightMotors.getPeakOutput(),
+                           .timedOut = isDone()};
+    // let the robot come to a stop, for at most 2 seconds
+    for (Time t = 0_sec; t < 2_sec; t += m_period) {
+        if (abs(m_leftMotors.getVelocity()) < 0.1_inps && abs(m_rightMotors.getVelocity()) < 0.1_inps) break;
+        step(m_period);
+    }
+    preview.finalPose = m_pose;
+    return preview;
+}
+
+void SimulatedEnvironment::step(Time dt) {
+    m_leftMotors.step(dt);
+    m_rightMotors.step(dt);
+    m_time += dt;
+    // integrate the pose, using the heading halfway through the step
+    const LinearVelocity left = m_leftMotors.getVelocity();
+    const LinearVelocity right = m_rightMotors.getVelocity();
+    const Length distance = (left + right) / 2 * dt;
+    const Angle deltaTheta = from_stRad(to_in((right - left) * dt) / to_in(m_model.trackWidth));
+    const Angle midTheta = m_pose.orientation + deltaTheta / 2;
+    m_pose.x += distance * cos(midTheta);
+    m_pose.y += distance * sin(midTheta);
+    m_pose.orientation += deltaTheta;
+}
+} // namespace lemlib
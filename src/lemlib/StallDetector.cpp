@@ -0,0 +1,49 @@
+#include "lemlib/StallDetector.hpp"
+
+using namespace units;
+
+namespace lemlib {
+StallDetector::StallDetector(Time window, Length maxProgress, Number minPower, AngularVelocity maxWheelSpeed)
+    : m_window(window),
+      m_maxProgress(maxProgress),
+      m_minPower(minPower),
+      m_maxWheelSpeed(maxWheelSpeed) {}
+
+bool StallDetector::update(Number power, Angle leftAngle, Angle rightAngle, Pose pose, Time now) {
+    if (m_stalled) return true;
+    // the drivetrain can only be stalled if it is trying to move
+    if (abs(power) < m_minPower) {
+        m_windowStart.reset();
+        return false;
+    }
+    // start a new window if the robot has made progress since the window started
+    if (m_windowStart == std::nullopt || m_windowPose.distanceTo(pose) > m_maxProgress) {
+        startWindow(leftAngle, rightAngle, pose, now);
+        return false;
+    }
+    // wait until the window is over
+    const Time elapsed = now - *m_windowStart;
+    if (elapsed < m_window) return false;
+    // check the average speed of the wheels over the window, in case only motor stalls should be detected
+    const AngularVelocity wheelSpeed =
+        (abs(leftAngle - m_windowLeftAngle) + abs(rightAngle - m_windowRightAngle)) / (2 * elapsed);
+    if (wheelSpeed > m_maxWheelSpeed) {
+        startWindow(leftAngle, rightAngle, pose, now);
+        return false;
+    }
+    m_stalled = true;
+    return true;
+}
+
+void StallDetector::reset() {
+    m_windowStart.reset();
+    m_stalled = false;
+}
+
+void StallDetector::startWindow(Angle leftAngle, Angle rightAngle, Pose pose, Time now) {
+    m_windowStart = now;
+    m_windowPose = pose;
+    m_windowLeftAngle = leftAngle;
+    m_windowRightAngle = rightAngle;
+}
+} // namespace lemlib
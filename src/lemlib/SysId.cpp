@@ -0,0 +1,57 @@
+#include "lemlib/SysId.hpp"
+#include "LemLog/logger/Helper.hpp"
+#include "lemlib/MotionEnvironment.hpp"
+
+using namespace units;
+
+namespace lemlib {
+
+static logger::Helper logHelper("lemlib/sysid");
+
+std::vector<SysIdSample> runSysIdTest(SysIdTest test, const SysIdSettings& settings) {
+    const bool quasistatic = test == SysIdTest::QUASISTATIC_FORWARD || test == SysIdTest::QUASISTATIC_BACKWARD ||
+                             test == SysIdTest::TURN;
+    const Number direction = (test == SysIdTest::QUASISTATIC_BACKWARD || test == SysIdTest::DYNAMIC_BACKWARD) ? -1 : 1;
+    logHelper.info("running {} system identification test", quasistatic ? "quasistatic" : "dynamic");
+
+    RobotEnvironment env(settings.period, nullptr, settings.timeout, settings.poseGetter, settings.leftMotors,
+                         settings.rightMotors);
+    // convert the motor encoders to distance
+    const Angle leftStart = env.getLeftMotors().getAngle();
+    const Angle rightStart = env.getRightMotors().getAngle();
+    const auto getDistance = [&](Angle angle, Angle start) {
+        return to_stRad(angle - start) * settings.wheelDiameter / 2;
+    };
+    const Pose startPose = env.getPose();
+    std::optional<Time> startTime = std::nullopt;
+
+    std::vector<SysIdSample> samples;
+    samples.reserve(to_msec(settings.timeout) / to_msec(settings.period) + 1);
+    while (env.wait() && !env.isDone()) {
+        if (!startTime) startTime = env.getTime();
+        const Time time = env.getTime() - *startTime;
+        const Pose pose = env.getPose();
+        if (test != SysIdTest::TURN && startPose.distanceTo(pose) > settings.maxDistance) break;
+
+        // ramp the power up slowly for quasistatic tests, so acceleration is negligible
+        const Number power =
+            units::min(quasistatic ? Number(settings.rampRate * to_sec(time)) : settings.stepPower, Number(1));
+        const Number rightPower = power * direction;
+        const Number leftPower = test == SysIdTest::TURN ? -rightPower : rightPower;
+        samples.push_back({time, leftPower, rightPower, getDistance(env.getLeftMotors().getAngle(), leftStart),
+                           getDistance(env.getRightMotors().getAngle(), rightStart), pose});
+        env.getLeftMotors().move(leftPower);
+        env.getRightMotors().move(rightPower);
+    }
+
+    // stop the drivetrain
+    env.getLeftMotors().brake();
+    env.getRightMotors().brake();
+    logHelper.info("system identification test finished with {} samples", samples.size());
+    return samples;
+}
+
+std::vector<SysIdSample> runSysIdTest(SysIdTest test, SysIdSettings&& settings) {
+    return runSysIdTest(test, settings);
+}
+} // namespace lemlib
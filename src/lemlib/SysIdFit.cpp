@@ -0,0 +1,183 @@
+#include "lemlib/SysIdFit.hpp"
+#include <array>
+#include <cmath>
+#include <format>
+#include <sstream>
+
+using namespace units;
+
+namespace lemlib {
+DrivetrainModel SysIdResult::toModel(Length wheelDiameter) const {
+    DrivetrainModel model {.wheelDiameter = wheelDiameter};
+    if (trackWidth > 0_in) model.trackWidth = trackWidth;
+    if (feedforward.kV > 0) {
+        // at full power, the drivetrain settles where kS + kV * v = 1
+        model.maxSpeed = from_inps((1 - feedforward.kS) / feedforward.kV);
+        // kA / kV is the time constant of a first order system
+        model.timeConstant = from_sec(max(feedforward.kA, Number(0)) / feedforward.kV);
+    }
+    return model;
+}
+
+/**
+ * @brief Calculate the derivative of a series with central differences
+ *
+ * @param times the time of each value
+ * @param values the values
+ * @return std::vector<double> the derivative at each value. The first and last values use one sided differences
+ */
+static std::vector<double> differentiate(const std::vector<double>& times, const std::vector<double>& values) {
+    std::vector<double> out(values.size(), 0);
+    if (values.size() < 2) return out;
+    for (size_t i = 0; i < values.size(); i++) {
+        const size_t prev = i == 0 ? 0 : i - 1;
+        const size_t next = i + 1 == values.size() ? i : i + 1;
+        const double dt = times.at(next) - times.at(prev);
+        if (dt > 0) out.at(i) = (values.at(next) - values.at(prev)) / dt;
+    }
+    return out;
+}
+
+SysIdResult fitFeedforward(std::span<const std::vector<SysIdSample>> tests) {
+    // normal equations of least squares, for power = kS * sgn(v) + kV * v + kA * a
+    std::array<std::array<double, 3>, 3> ata = {};
+    std::array<double, 3> atb = {};
+    // used to calculate r squared
+    std::vector<std::array<double, 4>> rows;
+
+    for (const std::vector<SysIdSample>& samples : tests) {
+        std::vector<double> times, left, right;
+        for (const SysIdSample& sample : samples) {
+            times.push_back(to_sec(sample.time));
+            left.push_back(to_in(sample.leftDistance));
+            right.push_back(to_in(sample.rightDistance));
+        }
+        const std::vector<double> leftVel = differentiate(times, left);
+        const std::vector<double> rightVel = differentiate(times, right);
+        const std::vector<double> leftAccel = differentiate(times, leftVel);
+        const std::vector<double> rightAccel = differentiate(times, rightVel);
+        // skip the first and last samples, since their differences are one sided
+        for (size_t i = 1; i + 1 < samples.size(); i++) {
+            const std::array<std::array<double, 3>, 2> sides = {{{samples.at(i).leftPower.internal(), leftVel.at(i),
+                                                                  leftAccel.at(i)},
+                                                                 {samples.at(i).rightPower.internal(), rightVel.at(i),
+                                                                  rightAccel.at(i)}}};
+            for (const auto& [power, velocity, acceleration] : sides) {
+                // static friction can hold any power below kS, so stationary samples say nothing about the gains
+                if (std::abs(velocity) < 0.5) continue;
+                const std::array<double, 3> x = {velocity > 0 ? 1.0 : -1.0, velocity, acceleration};
+                for (int r = 0; r < 3; r++) {
+                    for (int c = 0; c < 3; c++) ata[r][c] += x[r] * x[c];
+                    atb[r] += x[r] * power;
+                }
+                rows.push_back({x[0], x[1], x[2], power});
+            }
+        }
+    }
+
+    // solve the normal equations with gaussian elimination
+    for (int col = 0; col < 3; col++) {
+        int pivot = col;
+        for (int r = col + 1; r < 3; r++) {
+            if (std::abs(ata[r][col]) > std::abs(ata[pivot][col])) pivot = r;
+        }
+        // not enough data to fit the gains
+        if (std::abs(ata[pivot][col]) < 1e-9) return {};
+        std::swap(ata[col], ata[pivot]);
+        std::swap(atb[col], atb[pivot]);
+        for (int r = col + 1; r < 3; r++) {
+            const double factor = ata[r][col] / ata[col][col];
+            for (int c = col; c < 3; c++) ata[r][c] -= factor * ata[col][c];
+            atb[r] -= factor * atb[col];
+        }
+    }
+    std::array<double, 3> gains = {};
+    for (int r = 2; r >= 0; r--) {
+        double sum = atb[r];
+        for (int c = r + 1; c < 3; c++) sum -= ata[r][c] * gains[c];
+        gains[r] = sum / ata[r][r];
+    }
+
+    // calculate how much of the variance in power is explained by the fit
+    double mean = 0;
+    for (const auto& row : rows) mean += row[3];
+    mean /= rows.size();
+    double residual = 0;
+    double total = 0;
+    for (const auto& row : rows) {
+        const double predicted = gains[0] * row[0] + gains[1] * row[1] + gains[2] * row[2];
+        residual += (row[3] - predicted) * (row[3] - predicted);
+        total += (row[3] - mean) * (row[3] - mean);
+    }
+
+    SysIdResult result;
+    result.feedforward = {.kS = gains[0], .kV = gains[1], .kA = gains[2]};
+    result.rSquared = total > 0 ? 1 - residual / total : 0;
+    return result;
+}
+
+SysIdResult fitFeedforward(std::initializer_list<std::vector<SysIdSample>> tests) {
+    return fitFeedforward(std::span<const std::vector<SysIdSample>>(tests.begin(), tests.size()));
+}
+
+Length fitTrackWidth(std::span<const SysIdSample> samples) {
+    std::vector<double> times, left, right, heading;
+    for (const SysIdSample& sample : samples) {
+        times.push_back(to_sec(sample.time));
+        left.push_back(to_in(sample.leftDistance));
+        right.push_back(to_in(sample.rightDistance));
+        // unwrap the heading, so its derivative doesn't jump when the heading wraps around
+        const double theta = to_stRad(sample.pose.orientation);
+        heading.push_back(heading.empty() ? theta : heading.back() + std::remainder(theta - heading.back(), 2 * M_PI));
+    }
+    const std::vector<double> leftVel = differentiate(times, left);
+    const std::vector<double> rightVel = differentiate(times, right);
+    const std::vector<double> angularVel = differentiate(times, heading);
+    // least squares on (right speed - left speed) = track width * angular velocity
+    double numerator = 0;
+    double denominator = 0;
+    for (size_t i = 1; i + 1 < samples.size(); i++) {
+        numerator += (rightVel.at(i) - leftVel.at(i)) * angularVel.at(i);
+        denominator += angularVel.at(i) * angularVel.at(i);
+    }
+    if (denominator == 0) return 0_in;
+    return from_in(numerator / denominator);
+}
+
+std::string toCsv(std::span<const SysIdSample> samples) {
+    std::string out = "time,leftPower,rightPower,leftDistance,rightDistance,x,y,theta\n";
+    for (const SysIdSample& sample : samples) {
+        out += std::format("{:.6f},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f},{:.6f}\n", to_sec(sample.time),
+                           sample.leftPower.internal(), sample.rightPower.internal(), to_in(sample.leftDistance),
+                           to_in(sample.rightDistance), to_in(sample.pose.x), to_in(sample.pose.y),
+                           to_stRad(sample.pose.orientation));
+    }
+    return out;
+}
+
+std::vector<SysIdSample> fromCsv(const std::string& csv) {
+    std::vector<SysIdSample> samples;
+    std::stringstream stream(csv);
+    std::string line;
+    while (std::getline(stream, line)) {
+        std::array<double, 8> values;
+        std::stringstream lineStream(line);
+        std::string value;
+        size_t count = 0;
+        try {
+            while (count < values.size() && std::getline(lineStream, value, ',')) values.at(count++) = std::stod(value);
+        } catch (const std::exception&) {
+            // the header, or a malformed line
+            continue;
+        }
+        if (count != values.size()) continue;
+        samples.push_back({from_sec(values[0]),
+                           values[1],
+                           values[2],
+                           from_in(values[3]),
+                           from_in(values[4]),
+                           {from_in(values[5]), from_in(values[6]), from_stRad(values[7])}});
+    }
+    return samples;
+}
+} // namespace lemlib
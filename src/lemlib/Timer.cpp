@@ -1,5 +1,6 @@
 #include "lemlib/Timer.hpp"
 #include "pros/rtos.hpp"
+#include <cmath>
 
 using namespace lemlib;
 
@@ -63,6 +64,16 @@ void Timer::resume() {
 }
 
 void Timer::waitUntilDone() {
-    do pros::delay(5);
-    while (!this->isDone());
+    while (!this->isDone()) {
+        // the timer can't finish while it's paused, so check again later
+        if (m_paused) {
+            pros::delay(5);
+            continue;
+        }
+        // sleep until the timer is expected to finish
+        // if the timer was paused in the meantime, it won't be done yet, so sleep again
+        const Time timeLeft = this->getTimeLeft();
+        std::uint32_t lastTime = to_msec(m_lastTime);
+        pros::Task::delay_until(&lastTime, std::ceil(to_msec(timeLeft)));
+    }
 }
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include "lemlib/Trajectory.hpp"
+#include <algorithm>
+#include <cmath>
+#include <format>
+
+using namespace units;
+
+namespace lemlib {
+Trajectory::Trajectory(std::vector<TrajectoryPoint> points, SequenceConstraints constraints)
+    : m_points(std::move(points)),
+      m_constraints(constraints) {}
+
+std::span<const TrajectoryPoint> Trajectory::getPoints() const { return m_points; }
+
+const SequenceConstraints& Trajectory::getConstraints() const { return m_constraints; }
+
+Time Trajectory::getDuration() const {
+    if (m_points.empty()) return 0_sec;
+    return m_points.back().time;
+}
+
+TrajectoryPoint Trajectory::sample(Time time) const {
+    if (time <= m_points.front().time) return m_points.front();
+    if (time >= m_points.back().time) return m_points.back();
+    // find the first point after the time
+    const auto upper = std::upper_bound(m_points.begin(), m_points.end(), time,
+                                        [](Time t, const TrajectoryPoint& point) { return t < point.time; });
+    const TrajectoryPoint& next = *upper;
+    const TrajectoryPoint& prev = *(upper - 1);
+    const Number t = (time - prev.time) / (next.time - prev.time);
+    // interpolate the heading the short way around
+    const Angle turn = from_stRad(std::remainder(to_stRad(next.pose.orientation - prev.pose.orientation), 2 * M_PI));
+    const Angle heading = prev.pose.orientation + turn * t;
+    return {{prev.pose.x + (next.pose.x - prev.pose.x) * t, prev.pose.y + (next.pose.y - prev.pose.y) * t, heading},
+            prev.speed + (next.speed - prev.speed) * t,
+            prev.curvature + (next.curvature - prev.curvature) * t,
+            time};
+}
+
+Number Trajectory::getCommandedSpeed(size_t index) const {
+    if (index + 1 >= m_points.size()) return 0;
+    return units::max(m_points.at(index).speed, m_constraints.minSpeed) / m_constraints.maxSpeed;
+}
+
+std::string Trajectory::toPathFile() const {
+    std::string out;
+    for (size_t i = 0; i < m_points.size(); i++) {
+        const TrajectoryPoint& point = m_points.at(i);
+        out += std::format("{:.3f}, {:.3f}, {:.3f}\n", to_in(point.pose.x), to_in(point.pose.y),
+                           getCommandedSpeed(i).internal());
+    }
+    out += "endData\n";
+    return out;
+}
+
+/**
+ * @brief Get the direction of the path at a target
+ *
+ * @param targets the targets
+ * @param positions the positions of the targets, after cutting corners
+ * @param i the index of the target
+ * @return Angle the direction of the path
+ */
+static Angle getDirection(std::span<const SequenceTarget> targets, const std::vector<V2Position>& positions,
+                          size_t i) {
+    if (targets[i].heading) return *targets[i].heading;
+    // point from the previous target to the next one, like a Catmull-Rom spline
+    const V2Position& prev = positions.at(i == 0 ? 0 : i - 1);
+    const V2Position& next = positions.at(i + 1 == positions.size() ? i : i + 1);
+    return prev.angleTo(next);
+}
+
+/**
+ * @brief Get the signed curvature of the circle through 3 points
+ *
+ * @param a the first point
+ * @param b the second point
+ * @param c the third point
+ * @return Curvature the curvature. Positive when the points turn counterclockwise
+ */
+static Curvature getCurvature(V2Position a, V2Position b, V2Position c) {
+    const V2Position ab = b - a;
+    const V2Position bc = c - b;
+    const auto denominator = a.distanceTo(b) * b.distanceTo(c) * a.distanceTo(c);
+    if (denominator.internal() == 0) return Curvature(0);
+    return 2 * (ab.x * bc.y - ab.y * bc.x) / denominator;
+}
+
+Trajectory compileSequence(std::span<const SequenceTarget> targets, const SequenceConstraints& constraints) {
+    if (targets.size() < 2) return {{}, constraints};
+
+    // cut corners by moving each target towards its neighbors, by at most its tolerance
+    std::vector<V2Position> positions;
+    positions.reserve(targets.size());
+    for (size_t i = 0; i < targets.size(); i++) {
+        const V2Position& position = targets[i].position;
+        if (i == 0 || i + 1 == targets.size() || targets[i].tolerance <= 0_in) {
+            positions.push_back(position);
+            continue;
+        }
+        const V2Position midpoint = (positions.at(i - 1) + targets[i + 1].position) / 2;
+        const Length shift = units::min(targets[i].tolerance, position.distanceTo(midpoint) / 2);
+        positions.push_back(position + V2Position::fromPolar(position.angleTo(midpoint), shift));
+    }
+
+    // sample the spline densely, then only keep points that are far enough apart
+    std::vector<V2Position> path = {positions.front()};
+    constexpr int SAMPLES = 200;
+    for (size_t i = 0; i + 1 < positions.size(); i++) {
+        const V2Position& p0 = positions.at(i);
+        const V2Position& p1 = positions.at(i + 1);
+        const Length chord = p0.distanceTo(p1);
+        const V2Position m0 = V2Position::fromPolar(getDirection(targets, positions, i), chord);
+        const V2Position m1 = V2Position::fromPolar(getDirection(targets, positions, i + 1), chord);
+        for (int j = 1; j <= SAMPLES; j++) {
+            const double t = double(j) / SAMPLES;
+            const double t2 = t * t;
+            const double t3 = t2 * t;
+            const V2Position point = p0 * (2 * t3 - 3 * t2 + 1) + m0 * (t3 - 2 * t2 + t) + p1 * (-2 * t3 + 3 * t2) +
+                                     m1 * (t3 - t2);
+            // always keep the last point, so the path ends exactly at the last target
+            const bool last = i + 2 == positions.size() && j == SAMPLES;
+            if (last || path.back().distanceTo(point) >= constraints.spacing) path.push_back(point);
+        }
+    }
+
+    // limit the speed of each point by the curvature of the path
+    std::vector<TrajectoryPoint> points;
+    points.reserve(path.size());
+    for (size_t i = 0; i < path.size(); i++) {
+        const Curvature curvature = i == 0 || i + 1 == path.size()
+                                        ? Curvature(0)
+                                        : getCurvature(path.at(i - 1), path.at(i), path.at(i + 1));
+        // the outer wheels must not exceed the top speed
+        LinearVelocity speed = constraints.maxSpeed / (1 + abs(curvature) * constraints.trackWidth / 2);
+        // the robot must not slide out of the turn
+        if (curvature != Curvature(0)) speed = units::min(speed, sqrt(constraints.maxAcceleration / abs(curvature)));
+        const Angle heading = i + 1 == path.size() ? path.at(i - 1).angleTo(path.at(i))
+                                                   : path.at(i).angleTo(path.at(i + 1));
+        points.push_back({{path.at(i).x, path.at(i).y, heading}, speed, curvature, 0_sec});
+    }
+    // use the headings of the first and last targets if they were given
+    if (targets.front().heading) points.front().pose.orientation = *targets.front().heading;
+    if (targets.back().heading) points.back().pose.orientation = *targets.back().heading;
+
+    // start and end at rest, and respect the acceleration limit in between
+    points.front().speed = 0_inps;
+    points.back().speed = 0_inps;
+    for (size_t i = 1; i < points.size(); i++) {
+        const Length distance = points.at(i - 1).pose.distanceTo(points.at(i).pose);
+        const LinearVelocity reachable =
+            sqrt(square(points.at(i - 1).speed) + 2 * constraints.maxAcceleration * distance);
+        points.at(i).speed = units::min(points.at(i).speed, reachable);
+    }
+    for (size_t i = points.size() - 1; i > 0; i--) {
+        const Length distance = points.at(i - 1).pose.distanceTo(points.at(i).pose);
+        const LinearVelocity reachable = sqrt(square(points.at(i).speed) + 2 * constraints.maxAcceleration * distance);
+        points.at(i - 1).speed = units::min(points.at(i - 1).speed, reachable);
+    }
+
+    // calculate when the robot reaches each point, assuming constant acceleration between points
+    for (size_t i = 1; i < points.size(); i++) {
+        const Length distance = points.at(i - 1).pose.distanceTo(points.at(i).pose);
+        const LinearVelocity averageSpeed = (points.at(i - 1).speed + points.at(i).speed) / 2;
+        const Time delta = averageSpeed > 0_inps ? distance / averageSpeed : 0_sec;
+        points.at(i).time = points.at(i - 1).time + delta;
+    }
+
+    return {std::move(points), constraints};
+}
+
+Trajectory compileSequence(std::initializer_list<SequenceTarget> targets, const SequenceConstraints& constraints) {
+    return compileSequence(std::span<const SequenceTarget>(targets.begin(), targets.size()), constraints);
+}
+} // namespace lemlib
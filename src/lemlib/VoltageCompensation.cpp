@@ -0,0 +1,77 @@
+#include "lemlib/VoltageCompensation.hpp"
+#include "LemLog/logger/Helper.hpp"
+#include "pros/error.h"
+#include "pros/misc.h"
+#include "pros/rtos.hpp"
+#include <mutex>
+
+using namespace units;
+
+namespace lemlib {
+
+static logger::Helper logHelper("lemlib/VoltageCompensation");
+
+VoltageCompensator::VoltageCompensator(Voltage nominalVoltage, Time timeConstant, Time period)
+    : m_nominalVoltage(nominalVoltage),
+      m_timeConstant(timeConstant),
+      m_period(period) {}
+
+void VoltageCompensator::update() {
+    const std::uint64_t now = pros::micros();
+    // failed reads wait for the period too, so a missing battery reading isn't retried every iteration
+    if (m_lastAttempt && from_usec(now - *m_lastAttempt) < m_period) return;
+    m_lastAttempt = now;
+    const std::int32_t millivolts = pros::c::battery_get_voltage();
+    // PROS_ERR, or a reading no battery could produce
+    if (millivolts <= 0 || millivolts == PROS_ERR) {
+        // only warn once until the battery can be read again
+        if (!m_readFailed) {
+            logHelper.warn("Failed to read the battery voltage, outputs will not be compensated until it can be read");
+        }
+        m_readFailed = true;
+        return;
+    }
+    m_readFailed = false;
+    const Voltage voltage = from_mvolt(millivolts);
+    if (!m_voltage) {
+        m_voltage = voltage;
+    } else {
+        // exponential moving average with the given time constant
+        const Time dt = from_usec(now - m_lastRead);
+        const Number alpha = dt / (m_timeConstant + dt);
+        m_voltage = *m_voltage + (voltage - *m_voltage) * alpha;
+    }
+    m_lastRead = now;
+}
+
+Number VoltageCompensator::getScale() {
+    std::lock_guard lock(m_mutex);
+    update();
+    if (!m_voltage) return 1;
+    return m_nominalVoltage / *m_voltage;
+}
+
+std::optional<Voltage> VoltageCompensator::getVoltage() {
+    std::lock_guard lock(m_mutex);
+    update();
+    return m_voltage;
+}
+
+CompensatedMotors::CompensatedMotors(MotorGroup& motors, VoltageCompensator* compensator)
+    : m_motors(motors),
+      m_compensator(compensator) {}
+
+int CompensatedMotors::move(Number percent) {
+    if (m_compensator == nullptr) return m_motors.move(percent);
+    // the motors can't go past full power, however low the battery is
+    return m_motors.move(units::clamp(percent * m_compensator->getScale(), Number(-1), Number(1)));
+}
+
+int CompensatedMotors::brake() { return m_motors.brake(); }
+
+int CompensatedMotors::setBrakeMode(BrakeMode mode) { return m_motors.setBrakeMode(mode); }
+
+BrakeMode CompensatedMotors::getBrakeMode() { return m_motors.getBrakeMode(); }
+
+Angle CompensatedMotors::getAngle() { return m_motors.getAngle(); }
+} // namespace lemlib
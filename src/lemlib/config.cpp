@@ -0,0 +1,20 @@
+#include "lemlib/config.hpp"
+#include "LemLog/logger/Helper.hpp"
+#include "lemlib/LQR.hpp"
+#include "lemlib/Simulation.hpp"
+
+// default values for optional configuration
+// these are weak symbols, so they are replaced if the user defines them
+
+extern lemlib::Event* const motion_trigger __attribute__((weak)) = nullptr;
+extern const Number lateral_jerk __attribute__((weak)) = 0;
+extern lemlib::VoltageCompensator* const voltage_compensation __attribute__((weak)) = nullptr;
+extern const logger::Level log_level __attribute__((weak)) = logger::Level::INFO;
+extern const Time motion_period __attribute__((weak)) = 10_msec;
+extern const lemlib::DrivetrainModel drivetrain_model __attribute__((weak)) = {};
+
+__attribute__((weak)) const lemlib::UnicycleLQR& trajectory_controller() {
+    // constructed on first use, so programs which never track a trajectory don't precompute its gains
+    static const lemlib::UnicycleLQR controller;
+    return controller;
+}
@@ -0,0 +1,142 @@
+#include "lemlib/motions/autotune.hpp"
+#include "LemLog/logger/Helper.hpp"
+#include "lemlib/ControlPipeline.hpp"
+#include "lemlib/MotionEnvironment.hpp"
+#include "lemlib/util.hpp"
+#include <algorithm>
+#include <numbers>
+
+using namespace units;
+
+namespace lemlib {
+
+static logger::Helper logHelper("lemlib/motions/autotune");
+
+Gains computeGains(Number ultimateGain, Time ultimatePeriod, TuningRule rule) {
+    // proportional gain, integral time, and derivative time, as fractions of the ultimate gain and period
+    struct Rule {
+            double kP;
+            double tI;
+            double tD;
+    };
+
+    const Rule r = [&]() -> Rule {
+        switch (rule) {
+            case TuningRule::ZIEGLER_NICHOLS: return {0.6, 0.5, 0.125};
+            case TuningRule::ZIEGLER_NICHOLS_PD: return {0.8, 0, 0.125};
+            case TuningRule::TYREUS_LUYBEN: return {1 / 2.2, 2.2, 1 / 6.3};
+            case TuningRule::PESSEN_INTEGRAL: return {0.7, 0.4, 0.15};
+            case TuningRule::SOME_OVERSHOOT: return {0.33, 0.5, 1.0 / 3};
+            case TuningRule::NO_OVERSHOOT: return {0.2, 0.5, 1.0 / 3};
+        }
+        return {0, 0, 0};
+    }();
+
+    const Number kP = r.kP * ultimateGain;
+    // an integral time of 0 means there is no integral term
+    const Number kI = r.tI == 0 ? Number(0) : Number(kP / (r.tI * to_sec(ultimatePeriod)));
+    const Number kD = kP * r.tD * to_sec(ultimatePeriod);
+    return {kP, kI, kD};
+}
+
+/**
+ * @brief Run a relay experiment on the drivetrain
+ *
+ * @param env the environment to run the tune in, either the robot or a simulation
+ * @param mode which controller to tune
+ * @param params the parameters of the tune
+ * @return AutotuneResult the measurements and recommended gains
+ */
+template <typename Environment>
+static AutotuneResult autotune(Environment& env, AutotuneMode mode, const AutotuneParams& params) {
+    const Pose start = env.getPose();
+    // the error from where the robot started, in the same units motions pass to their PID controllers
+    const auto calculateError = [&](const Pose& pose) -> Number {
+        if (mode == AutotuneMode::ANGULAR) return to_stRad(angleError(start.orientation, pose.orientation));
+        return to_m((start.x - pose.x) * cos(start.orientation) + (start.y - pose.y) * sin(start.orientation));
+    };
+
+    pipeline::DriveOutput output(env.getLeftMotors(), env.getRightMotors(), pipeline::Unmixed());
+    Number relay = params.relayPower;
+    // extremes of the error during the current cycle
+    Number maxError = 0;
+    Number minError = 0;
+    std::optional<Time> cycleStart = std::nullopt;
+    int cycle = 0;
+    Number amplitudeSum = 0;
+    Time periodSum = 0_sec;
+    // at least one oscillation has to be measured, since the measurements are averaged
+    const int cycles = std::max(params.cycles, 1);
+
+    while (env.wait() && !env.isDone() && cycle <= cycles) {
+        const Number error = calculateError(env.getPose());
+        maxError = units::max(maxError, error);
+        minError = units::min(minError, error);
+
+        // a cycle ends every time the relay switches to positive power
+        if (error > params.hysteresis && relay < 0) {
+            relay = params.relayPower;
+            if (cycleStart) {
+                // the first cycle is skipped, since the robot starts at rest
+                if (cycle > 0) {
+                    amplitudeSum += (maxError - minError) / 2;
+                    periodSum += env.getTime() - *cycleStart;
+                    logHelper.debug("cycle {}: amplitude {:.4f}, period {}", cycle, (maxError - minError) / 2,
+                                    env.getTime() - *cycleStart);
+                }
+                cycle++;
+            }
+            cycleStart = env.getTime();
+            maxError = error;
+            minError = error;
+        } else if (error < -params.hysteresis && relay > 0) {
+            relay = -params.relayPower;
+        }
+
+        if (mode == AutotuneMode::ANGULAR) output(0, relay);
+        else output(relay, 0);
+    }
+
+    // stop the drivetrain
+    env.getLeftMotors().brake();
+    env.getRightMotors().brake();
+
+    AutotuneResult result;
+    if (cycle <= cycles) return result;
+    const Number amplitude = amplitudeSum / cycles;
+    result.ultimatePeriod = periodSum / cycles;
+    // describing function of a relay with hysteresis
+    const Number effectiveAmplitude =
+        amplitude > params.hysteresis ? Number(sqrt(amplitude * amplitude - params.hysteresis * params.hysteresis))
+                                      : amplitude;
+    if (effectiveAmplitude <= 0) return result;
+    result.ultimateGain = 4 * params.relayPower / (std::numbers::pi * effectiveAmplitude);
+    result.gains = computeGains(result.ultimateGain, result.ultimatePeriod, params.rule);
+    result.success = true;
+    return result;
+}
+
+AutotuneResult autotune(AutotuneMode mode, PID& pid, Time timeout, const AutotuneParams& params,
+                        const AutotuneSettings& settings) {
+    logHelper.info("autotuning {} controller", mode == AutotuneMode::ANGULAR ? "angular" : "lateral");
+    RobotEnvironment env(settings.period, settings.trigger, timeout, settings.poseGetter, settings.leftMotors,
+                         settings.rightMotors);
+    const AutotuneResult result = autotune(env, mode, params);
+    if (!result.success) {
+        logHelper.warn("autotune did not measure {} oscillations before the timeout, gains were not changed",
+                       std::max(params.cycles, 1));
+        return result;
+    }
+    logHelper.info("autotune measured ultimate gain {:.4f} and ultimate period {}, gains: kP {:.4f}, kI {:.4f}, "
+                   "kD {:.4f}",
+                   result.ultimateGain, result.ultimatePeriod, result.gains.kP, result.gains.kI, result.gains.kD);
+    pid.setGains(result.gains);
+    pid.reset();
+    return result;
+}
+
+AutotuneResult autotune(AutotuneMode mode, PID& pid, Time timeout, const AutotuneParams& params,
+                        AutotuneSettings&& settings) {
+    return autotune(mode, pid, timeout, params, settings);
+}
+} // namespace lemlib
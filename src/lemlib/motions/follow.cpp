@@ -1,7 +1,6 @@
 #include "lemlib/motions/follow.hpp"
 #include "LemLog/logger/Helper.hpp"
-#include "lemlib/MotionCancelHelper.hpp"
-#include "lemlib/Timer.hpp"
+#include "lemlib/MotionEnvironment.hpp"
 #include "lemlib/util.hpp"
 
 using namespace units;
@@ -55,11 +54,17 @@ static std::string stringToHex(const std::string& input) {
 
 class Waypoint : public V2Position {
     public:
-        Waypoint(Length x, Length y, Number speed)
+        Waypoint(Length x, Length y, Number speed, LinearVelocity velocity = 0_inps,
+                 LinearAcceleration acceleration = 0_inps2)
             : V2Position(x, y),
-              speed(speed) {}
+              speed(speed),
+              velocity(velocity),
+              acceleration(acceleration) {}
 
         Number speed;
+        // planned velocity and acceleration, only known for compiled trajectories
+        LinearVelocity velocity;
+        LinearAcceleration acceleration;
 };
 
 /**
@@ -97,6 +102,31 @@ static std::vector<Waypoint> getPath(const asset& asset) {
     return path;
 }
 
+/**
+ * @brief Get the path of a compiled trajectory
+ *
+ * @param trajectory the trajectory
+ * @return std::vector<Waypoint> vector of points on the path
+ */
+static std::vector<Waypoint> getPath(const Trajectory& trajectory) {
+    std::vector<Waypoint> path;
+    path.reserve(trajectory.getPoints().size());
+    const std::span<const TrajectoryPoint> points = trajectory.getPoints();
+    for (size_t i = 0; i < points.size(); i++) {
+        const TrajectoryPoint& point = points[i];
+        // constant acceleration between this point and the next one
+        const LinearAcceleration acceleration = [&] {
+            if (i + 1 == points.size()) return 0_inps2;
+            const Length distance = point.pose.distanceTo(points[i + 1].pose);
+            if (distance == 0_in) return 0_inps2;
+            return (square(points[i + 1].speed) - square(point.speed)) / (2 * distance);
+        }();
+        path.push_back({point.pose.x, point.pose.y, trajectory.getCommandedSpeed(i),
+                        units::max(point.speed, trajectory.getConstraints().minSpeed), acceleration});
+    }
+    return path;
+}
+
 /**
  * @brief find the closest point on the path to the robot
  *
@@ -196,21 +226,35 @@ static LookaheadPoint findLookaheadPoint(LookaheadPoint lastLookaheadPoint, Pose
     return lastLookaheadPoint;
 }
 
-void follow(const asset& asset, Length lookaheadDistance, Time timeout, FollowParams params, FollowSettings settings) {
-    const std::vector<Waypoint> path = getPath(asset); // get list of path points
-    if (path.size() == 0) {
-        logHelper.error("No points in path! Do you have the right format? Skipping motion");
-        return;
-    }
+/**
+ * @brief Follow a path
+ *
+ * @param env the environment to run the motion in, either the robot or a simulation
+ * @param path the path to follow. Must not be empty
+ * @param lookaheadDistance the lookahead distance
+ * @param params the parameters of the motion
+ * @param settings the settings of the motion
+ * @param profiled whether the path has planned velocities and accelerations, which can be used for feedforward
+ */
+template <typename Environment>
+static void follow(Environment& env, const std::vector<Waypoint>& path, Length lookaheadDistance,
+                   const FollowParams& params, FollowSettings& settings, bool profiled = false) {
     LookaheadPoint lastLookahead = {path.at(0).x, path.at(0).y, 0};
     Number prevVel = 0;
-
-    lemlib::MotionCancelHelper helper(10_msec); // cancel helper
-    Timer timer(timeout);
-    while (!timer.isDone() && helper.wait()) {
+    SCurveSlew lateralLimiter(params.lateralSlew, params.lateralJerk);
+    // length of the path from each point to the end, used to estimate progress
+    const std::vector<Length> remainingLength = [&] {
+        std::vector<Length> out(path.size(), 0_in);
+        for (int i = path.size() - 2; i >= 0; i--) out.at(i) = out.at(i + 1) + path.at(i).distanceTo(path.at(i + 1));
+        return out;
+    }();
+    ProgressTracker progress(env.getPose());
+    ActionRunner actions(params.actions);
+
+    while (!env.isDone() && env.wait()) {
         // get the current position of the robot
         const Pose pose = [&] {
-            Pose out = settings.poseGetter();
+            Pose out = env.getPose();
             if (params.reversed) out.orientation -= 180_stDeg;
             return out;
         }();
@@ -225,21 +269,41 @@ void follow(const asset& asset, Length lookaheadDistance, Time timeout, FollowPa
             findLookaheadPoint(lastLookahead, pose, path, closestPoint, lookaheadDistance);
         lastLookahead = lookaheadPose; // update last lookahead position
 
+        // run actions
+        progress.update(pose, env.getDelta());
+        {
+            const Length lateralError = pose.distanceTo(path.at(closestPoint));
+            const Angle angularError = angleError(pose.orientation, pose.angleTo(lookaheadPose));
+            env.updateActions(actions,
+                              progress.getLinearProgress(lateralError + remainingLength.at(closestPoint),
+                                                         lateralError, angularError));
+        }
+
         // get the curvature of the arc between the robot and the lookahead point
         const Curvature curvature = getSignedTangentArcCurvature(pose, lookaheadPose);
 
         // get the target velocity of the robot
         const Number targetVel = [&] {
             Number out = path.at(closestPoint).speed;
-            out = slew(out, prevVel, params.lateralSlew, helper.getDelta());
+            out = lateralLimiter.update(out, prevVel, env.getDelta());
             prevVel = out;
             return out;
         }();
         // calculate target left and right velocities
-
         Number targetLeftVel = targetVel * (2 + curvature * settings.trackWidth) / 2;
         Number targetRightVel = targetVel * (2 - curvature * settings.trackWidth) / 2;
 
+        // track the planned velocity and acceleration of each side with feedforward, if possible
+        if (profiled && settings.feedforward) {
+            const Waypoint& waypoint = path.at(closestPoint);
+            const Number leftScale = (2 + curvature * settings.trackWidth) / 2;
+            const Number rightScale = (2 - curvature * settings.trackWidth) / 2;
+            targetLeftVel = settings.feedforward->calculate(to_inps(waypoint.velocity * leftScale),
+                                                            to_inps2(waypoint.acceleration * leftScale));
+            targetRightVel = settings.feedforward->calculate(to_inps(waypoint.velocity * rightScale),
+                                                             to_inps2(waypoint.acceleration * rightScale));
+        }
+
         // ratio the speeds to respect the max speed
         float ratio = max(abs(targetLeftVel), abs(targetRightVel)) / 127;
         if (ratio > 1) {
@@ -249,16 +313,66 @@ void follow(const asset& asset, Length lookaheadDistance, Time timeout, FollowPa
 
         // move the drivetrain
         if (params.reversed) {
-            settings.leftMotors.move(-targetRightVel);
-            settings.rightMotors.move(-targetLeftVel);
+            env.getLeftMotors().move(-targetRightVel);
+            env.getRightMotors().move(-targetLeftVel);
         } else {
-            settings.leftMotors.move(targetLeftVel);
-            settings.rightMotors.move(targetRightVel);
+            env.getLeftMotors().move(targetLeftVel);
+            env.getRightMotors().move(targetRightVel);
         }
     }
 
     // stop the robot
-    settings.leftMotors.brake();
-    settings.rightMotors.brake();
+    env.getLeftMotors().brake();
+    env.getRightMotors().brake();
+}
+
+void follow(const asset& asset, Length lookaheadDistance, Time timeout, const FollowParams& params,
+            FollowSettings& settings) {
+    const std::vector<Waypoint> path = getPath(asset); // get list of path points
+    if (path.size() == 0) {
+        logHelper.error("No points in path! Do you have the right format? Skipping motion");
+        return;
+    }
+    RobotEnvironment env(settings.period, settings.trigger, timeout, settings.poseGetter, settings.leftMotors,
+                         settings.rightMotors);
+    follow(env, path, lookaheadDistance, params, settings);
+}
+
+void follow(const asset& asset, Length lookaheadDistance, Time timeout, const FollowParams& params,
+            FollowSettings&& settings) {
+    follow(asset, lookaheadDistance, timeout, params, settings);
+}
+
+void follow(const Trajectory& trajectory, Length lookaheadDistance, Time timeout, const FollowParams& params,
+            FollowSettings& settings) {
+    const std::vector<Waypoint> path = getPath(trajectory);
+    if (path.size() == 0) {
+        logHelper.error("Trajectory is empty! Did it have at least 2 targets? Skipping motion");
+        return;
+    }
+    if (log_level <= logger::Level::INFO) {
+        logHelper.info("following trajectory with {} points, expected to take {}", path.size(),
+                       trajectory.getDuration());
+    }
+    RobotEnvironment env(settings.period, settings.trigger, timeout, settings.poseGetter, settings.leftMotors,
+                         settings.rightMotors);
+    follow(env, path, lookaheadDistance, params, settings, true);
+}
+
+void follow(const Trajectory& trajectory, Length lookaheadDistance, Time timeout, const FollowParams& params,
+            FollowSettings&& settings) {
+    follow(trajectory, lookaheadDistance, timeout, params, settings);
+}
+
+MotionPreview previewFollow(const asset& asset, Length lookaheadDistance, Time timeout, const FollowParams& params,
+                            FollowSettings settings, Pose start, const DrivetrainModel& model) {
+    const std::vector<Waypoint> path = getPath(asset);
+    SimulatedEnvironment env(start, settings.period, timeout, model);
+    if (path.size() == 0) {
+        logHelper.error("No points in path! Do you have the right format? Skipping preview");
+        return env.finish();
+    }
+    follow(env, path, lookaheadDistance, params, settings);
+    return env.finish();
 }
 } // namespace lemlib
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include "lemlib/motions/moveToPoint.hpp"
 #include "LemLog/logger/Helper.hpp"
-#include "lemlib/MotionCancelHelper.hpp"
-#include "lemlib/Timer.hpp"
+#include "lemlib/ControlPipeline.hpp"
+#include "lemlib/MotionEnvironment.hpp"
 #include "lemlib/util.hpp"
 
 using namespace units;
@@ -10,28 +10,53 @@ namespace lemlib {
 
 static logger::Helper logHelper("lemlib/motions/moveToPoint");
 
-void moveToPoint(V2Position target, Time timeout, MoveToPointParams params, MoveToPointSettings settings) {
-    logHelper.info("moving to point {}", target);
+/**
+ * @brief Move the robot to a point
+ *
+ * @param env the environment to run the motion in, either the robot or a simulation
+ * @param target the point to move to
+ * @param params the parameters of the motion
+ * @param settings the settings of the motion
+ */
+template <typename Environment>
+static void moveToPoint(Environment& env, V2Position target, const MoveToPointParams& params,
+                        MoveToPointSettings& settings) {
+    // reset controller state in place
+    settings.lateralPID.reset();
+    settings.angularPID.reset();
+    settings.exitConditions.reset();
+    if (settings.stallDetector) settings.stallDetector->reset();
 
     // initialize persistent variables
-    const Angle initialAngle = settings.poseGetter().angleTo(target);
-    Timer timer(timeout);
+    const Angle initialAngle = env.getPose().angleTo(target);
     bool close = false;
+    Number maxLateralSpeed = params.maxLateralSpeed;
+    Number maxAngularSpeed = params.maxAngularSpeed;
     std::optional<bool> prevSide = std::nullopt;
-    Number prevLateralOut = 0;
-    Number prevAngularOut = 0;
+    // lateral output: PID, max speed, slew and min speed except when settling
+    auto lateralChain = pipeline::chain(
+        pipeline::PIDController(settings.lateralPID), pipeline::Clamp(maxLateralSpeed),
+        pipeline::Unless(close, pipeline::SCurve(params.lateralSlew, params.lateralJerk)),
+        pipeline::Unless(close, pipeline::ForceDirection(params.reversed, params.minLateralSpeed)));
+    // angular output: PID, max speed and slew
+    auto angularChain = pipeline::chain(pipeline::PIDController(settings.angularPID),
+                                        pipeline::Clamp(maxAngularSpeed), pipeline::Slew(params.angularSlew));
+    pipeline::DriveOutput output(env.getLeftMotors(), env.getRightMotors());
+    DriveOutputs prevOutput = {0, 0};
+    ProgressTracker progress(env.getPose());
+    ActionRunner actions(params.actions);
 
-    lemlib::MotionCancelHelper helper(10_msec); // cancel helper
+    lemlib::SubLoop lateralLoop(settings.lateralPeriod, settings.period); // the lateral output can run slower
     // loop until the motion has been cancelled, or the timer is done
-    while (helper.wait() && !timer.isDone()) {
+    while (env.wait() && !env.isDone()) {
         // get pose
-        const Pose pose = settings.poseGetter();
+        const Pose pose = env.getPose();
 
         // check if the robot is close enough to start settling
         if (!close && pose.distanceTo(target) < 7.5_in) {
             close = true;
-            params.maxLateralSpeed = max(abs(prevLateralOut), 4.7);
-            params.maxAngularSpeed = max(abs(prevLateralOut), 4.7);
+            maxLateralSpeed = max(abs(lateralChain.getPrevOutput()), 4.7);
+            maxAngularSpeed = max(abs(lateralChain.getPrevOutput()), 4.7);
         }
 
         // calculate error
@@ -41,8 +66,26 @@ void moveToPoint(V2Position target, Time timeout, MoveToPointParams params, Move
             return angleError(adjustedTheta, pose.angleTo(target));
         }();
 
+        // run actions
+        progress.update(pose, env.getDelta());
+        env.updateActions(actions,
+                          progress.getLinearProgress(pose.distanceTo(target), lateralError, angularError));
+
+        // schedule the gains by the speed of the robot, for gain schedules indexed by ScheduleVariable::EXTERNAL
+        settings.lateralPID.schedule(to_inps(progress.getLinearSpeed()));
+        settings.angularPID.schedule(to_radps(progress.getAngularSpeed()));
+
+        // exit if the drivetrain is pushing against something it can't move
+        if (settings.stallDetector &&
+            settings.stallDetector->update(max(abs(prevOutput.left), abs(prevOutput.right)),
+                                           env.getLeftMotors().getAngle(), env.getRightMotors().getAngle(), pose,
+                                           env.getTime())) {
+            logHelper.warn("Drivetrain stalled, exiting motion");
+            break;
+        }
+
         // check exit conditions
-        if (settings.exitConditions.update(lateralError) && close) break;
+        if (settings.exitConditions.update(lateralError, env.getTime()) && close) break;
         {
             const bool side = (pose.y - target.y) * -sin(initialAngle) <=
                               (pose.x - target.x) * cos(initialAngle) + params.earlyExitRange;
@@ -54,48 +97,43 @@ void moveToPoint(V2Position target, Time timeout, MoveToPointParams params, Move
         }
 
         // get lateral and angular outputs
-        const Number lateralOut = [&] -> Number {
-            // get raw output from PID
-            auto out = settings.lateralPID.update(to_m(lateralError));
-            // apply restrictions on maximum speed
-            out = clamp(out, -params.maxLateralSpeed, params.maxLateralSpeed);
-            // slew except when settling
-            out = close ? out : slew(out, prevLateralOut, params.lateralSlew, helper.getDelta());
-            // apply restrictions on minimum speed
-            if (!close && params.reversed) out = clamp(out, -params.maxLateralSpeed, -params.minLateralSpeed);
-            else if (!close && !params.reversed) out = clamp(out, params.minLateralSpeed, params.maxLateralSpeed);
-            // update previous value
-            prevLateralOut = out;
-            return out;
-        }();
-        const Number angularOut = [&] -> Number {
-            // if settling, disable turning
-            if (close) return 0;
-            // get raw output from PID
-            auto out = settings.angularPID.update(to_stRad(angularError));
-            // apply restrictions on maximum speed
-            out = clamp(out, -params.maxAngularSpeed, params.maxAngularSpeed);
-            // slew except when settling
-            out = slew(out, prevAngularOut, params.angularSlew, helper.getDelta());
-            // update previous value
-            prevAngularOut = out;
-            return out;
-        }();
+        // only recalculate the lateral output when the lateral loop is due
+        const Number lateralOut = lateralLoop.update(env.getDelta())
+                                      ? lateralChain.update(to_m(lateralError), lateralLoop.getDelta())
+                                      : lateralChain.getPrevOutput();
+        // if settling, disable turning
+        const Number angularOut = close ? Number(0) : angularChain.update(to_stRad(angularError), env.getDelta());
 
         // print debug info
-        logHelper.debug("Moving with {:.4f} lateral power, {:.4f} angular power, {:.4f} lateral error, {:.4f} angular "
-                        "error, {:.4f} dt",
-                        lateralOut, angularOut, lateralError, angularError, helper.getDelta());
+        if (log_level <= logger::Level::DEBUG) {
+            logHelper.debug("Moving with {:.4f} lateral power, {:.4f} angular power, {:.4f} lateral error, {:.4f} "
+                            "angular error, {:.4f} dt",
+                            lateralOut, angularOut, lateralError, angularError, env.getDelta());
+        }
 
-        // calculate drivetrain outputs
-        const auto out = desaturate(lateralOut, angularOut);
         // move the drivetrain
-        settings.leftMotors.move(out.left);
-        settings.rightMotors.move(out.right);
+        prevOutput = output(lateralOut, angularOut);
     }
     // stop motors
-    settings.leftMotors.brake();
-    settings.rightMotors.brake();
+    env.getLeftMotors().brake();
+    env.getRightMotors().brake();
+}
+
+void moveToPoint(V2Position target, Time timeout, const MoveToPointParams& params, MoveToPointSettings& settings) {
+    if (log_level <= logger::Level::DEBUG) logHelper.debug("moving to point {}", target);
+    RobotEnvironment env(settings.period, settings.trigger, timeout, settings.poseGetter, settings.leftMotors,
+                         settings.rightMotors);
+    moveToPoint(env, target, params, settings);
 }
 
+void moveToPoint(V2Position target, Time timeout, const MoveToPointParams& params, MoveToPointSettings&& settings) {
+    moveToPoint(target, timeout, params, settings);
+}
+
+MotionPreview previewMoveToPoint(V2Position target, Time timeout, const MoveToPointParams& params,
+                                 MoveToPointSettings settings, Pose start, const DrivetrainModel& model) {
+    SimulatedEnvironment env(start, settings.period, timeout, model);
+    moveToPoint(env, target, params, settings);
+    return env.finish();
+}
 }; // namespace lemlib
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include "lemlib/motions/moveToPose.hpp"
 #include "LemLog/logger/Helper.hpp"
-#include "lemlib/MotionCancelHelper.hpp"
-#include "lemlib/Timer.hpp"
+#include "lemlib/ControlPipeline.hpp"
+#include "lemlib/MotionEnvironment.hpp"
 #include "lemlib/util.hpp"
 
 using namespace units;
@@ -10,24 +10,67 @@ namespace lemlib {
 
 static logger::Helper logHelper("lemlib/motions/moveToPose");
 
-void moveToPose(Pose target, Time timeout, MoveToPoseParams params, MoveToPoseSettings settings) {
+/**
+ * @brief Move the robot to a pose
+ *
+ * @param env the environment to run the motion in, either the robot or a simulation
+ * @param target the pose to move to
+ * @param params the parameters of the motion
+ * @param settings the settings of the motion
+ */
+template <typename Environment>
+static void moveToPose(Environment& env, Pose target, const MoveToPoseParams& params, MoveToPoseSettings& settings) {
+    // reset controller state in place
+    settings.lateralPID.reset();
+    settings.angularPID.reset();
+    settings.lateralExitConditions.reset();
+    settings.angularExitConditions.reset();
+    if (settings.stallDetector) settings.stallDetector->reset();
+
     // initialize persistent variables
-    Pose lastPose = settings.poseGetter();
-    Timer timer(timeout);
+    Pose lastPose = env.getPose();
     bool close = false;
+    Number maxLateralSpeed = params.maxLateralSpeed;
     bool prevSameSide = false;
-    Number prevLateralOut = 0;
-    Number prevAngularOut = 0;
+    Number angularOut = 0;
+    Number maxSlipSpeed = INFINITY;
+    // angular output: PID and max speed
+    auto angularChain =
+        pipeline::chain(pipeline::PIDController(settings.angularPID), pipeline::Clamp(params.maxAngularSpeed));
+    auto lateralChain = pipeline::chain(
+        pipeline::PIDController(settings.lateralPID), pipeline::Clamp(maxLateralSpeed),
+        // limit acceleration
+        pipeline::Unless(close, pipeline::SCurve(params.lateralSlew, params.lateralJerk)),
+        // prevent slipping
+        pipeline::Clamp(maxSlipSpeed),
+        // prioritize angular movement over lateral movement
+        pipeline::Map([&](Number out) -> Number {
+            const Number overturn = abs(angularOut) + abs(out) - maxLateralSpeed;
+            if (overturn > 0) out -= out > 0 ? overturn : -overturn;
+            return out;
+        }),
+        // prevent moving in the wrong direction
+        pipeline::Unless(close, pipeline::ForceDirection(params.reversed)),
+        // constrain by minimum speed
+        pipeline::Map([&](Number out) -> Number {
+            if (params.reversed && -out < abs(params.minLateralSpeed) && out < 0) return -abs(params.minLateralSpeed);
+            if (!params.reversed && out < abs(params.minLateralSpeed) && out > 0) return abs(params.minLateralSpeed);
+            return out;
+        }));
+    pipeline::DriveOutput output(env.getLeftMotors(), env.getRightMotors());
+    DriveOutputs prevOutput = {0, 0};
+    ProgressTracker progress(lastPose);
+    ActionRunner actions(params.actions);
 
-    lemlib::MotionCancelHelper helper(10_msec);
+    lemlib::SubLoop lateralLoop(settings.lateralPeriod, settings.period); // the lateral output can run slower
     // loop until the motion has been cancelled, or the timer is done
-    while (helper.wait() && !timer.isDone()) {
-        const Pose pose = settings.poseGetter();
+    while (env.wait() && !env.isDone()) {
+        const Pose pose = env.getPose();
 
         // check if the robot is close enough to the target to start settling
         if (pose.distanceTo(target) < 7.5_in && close == false) {
             close = true;
-            params.maxLateralSpeed = max(abs(prevLateralOut), 0.47);
+            maxLateralSpeed = max(abs(lateralChain.getPrevOutput()), 0.47);
         }
 
         // find the carrot point
@@ -52,9 +95,28 @@ void moveToPose(Pose target, Time timeout, MoveToPoseParams params, MoveToPoseSe
             else return angleError(adjustedTheta, pose.angleTo(carrot));
         }();
 
+        // run actions. The remaining distance is estimated as the distance through the carrot point
+        progress.update(pose, env.getDelta());
+        env.updateActions(actions,
+                          progress.getLinearProgress(pose.distanceTo(carrot) + carrot.distanceTo(target), lateralError,
+                                                     angularError));
+
+        // schedule the gains by the speed of the robot, for gain schedules indexed by ScheduleVariable::EXTERNAL
+        settings.lateralPID.schedule(to_inps(progress.getLinearSpeed()));
+        settings.angularPID.schedule(to_radps(progress.getAngularSpeed()));
+
+        // exit if the drivetrain is pushing against something it can't move
+        if (settings.stallDetector &&
+            settings.stallDetector->update(max(abs(prevOutput.left), abs(prevOutput.right)),
+                                           env.getLeftMotors().getAngle(), env.getRightMotors().getAngle(), pose,
+                                           env.getTime())) {
+            logHelper.warn("Drivetrain stalled, exiting motion");
+            break;
+        }
+
         // check exit conditions
-        if (settings.lateralExitConditions.update(lateralError) &&
-            settings.angularExitConditions.update(angularError) && close) {
+        if (settings.lateralExitConditions.update(lateralError, env.getTime()) &&
+            settings.angularExitConditions.update(angularError, env.getTime()) && close) {
             break;
         }
         {
@@ -69,54 +131,42 @@ void moveToPose(Pose target, Time timeout, MoveToPoseParams params, MoveToPoseSe
         }
 
         // get lateral and angular outputs
-        const Number angularOut = [&] -> Number {
-            // get output from PID
-            Number out = settings.angularPID.update(to_stRad(angularError));
-            // restrict maximum speed
-            out = clamp(out, -params.maxAngularSpeed, params.maxAngularSpeed);
-            // update prevAngularOut
-            prevAngularOut = out;
-            return out;
-        }();
-        const Number lateralOut = [&] -> Number {
-            // get output from PID
-            Number out = settings.lateralPID.update(to_m(lateralError));
-            // restrict maximum speed
-            out = clamp(out, -params.maxLateralSpeed, params.maxLateralSpeed);
-            // limit acceleration
-            if (!close) out = slew(out, prevLateralOut, params.lateralSlew, helper.getDelta());
-            // prevent slipping
-            const Length radius = 1 / abs(getSignedTangentArcCurvature(pose, carrot));
-            const Number maxSlipSpeed = sqrt(params.driftCompensation * to_m(radius));
-            out = clamp(out, -maxSlipSpeed, maxSlipSpeed);
-            // prioritize angular movement over lateral movement
-            const Number overturn = abs(angularOut) + abs(out) - params.maxLateralSpeed;
-            if (overturn > 0) out -= out > 0 ? overturn : -overturn;
-            // prevent moving in the wrong direction
-            if (params.reversed && !close) out = units::min(out, 0);
-            else if (!params.reversed && !close) out = max(out, 0);
-            // constrain by minimum speed
-            if (params.reversed && -out < abs(params.minLateralSpeed) && out < 0) out = -abs(params.minLateralSpeed);
-            else if (!params.reversed && out < abs(params.minLateralSpeed) && out > 0)
-                out = abs(params.minLateralSpeed);
-            // update prevLateralOut
-            prevLateralOut = out;
-            return out;
-        }();
+        angularOut = angularChain.update(to_stRad(angularError), env.getDelta());
+        maxSlipSpeed = sqrt(params.driftCompensation * to_m(1 / abs(getSignedTangentArcCurvature(pose, carrot))));
+        // only recalculate the lateral output when the lateral loop is due
+        const Number lateralOut = lateralLoop.update(env.getDelta())
+                                      ? lateralChain.update(to_m(lateralError), lateralLoop.getDelta())
+                                      : lateralChain.getPrevOutput();
 
         // print debug info
-        logHelper.debug("Moving with {:.4f} lateral power, {:.4f} angular power, {:.4f} lateral error, {:.4f} angular "
-                        "error, {:.4f} dt",
-                        lateralOut, angularOut, lateralError, angularError, helper.getDelta());
+        if (log_level <= logger::Level::DEBUG) {
+            logHelper.debug("Moving with {:.4f} lateral power, {:.4f} angular power, {:.4f} lateral error, {:.4f} "
+                            "angular error, {:.4f} dt",
+                            lateralOut, angularOut, lateralError, angularError, env.getDelta());
+        }
 
-        // calculate drivetrain outputs
-        const auto out = desaturate(lateralOut, angularOut);
         // move the drivetrain
-        settings.leftMotors.move(out.left);
-        settings.rightMotors.move(out.right);
+        prevOutput = output(lateralOut, angularOut);
     }
     // stop motors
-    settings.leftMotors.brake();
-    settings.rightMotors.brake();
+    env.getLeftMotors().brake();
+    env.getRightMotors().brake();
+}
+
+void moveToPose(Pose target, Time timeout, const MoveToPoseParams& params, MoveToPoseSettings& settings) {
+    RobotEnvironment env(settings.period, settings.trigger, timeout, settings.poseGetter, settings.leftMotors,
+                         settings.rightMotors);
+    moveToPose(env, target, params, settings);
+}
+
+void moveToPose(Pose target, Time timeout, const MoveToPoseParams& params, MoveToPoseSettings&& settings) {
+    moveToPose(target, timeout, params, settings);
+}
+
+MotionPreview previewMoveToPose(Pose target, Time timeout, const MoveToPoseParams& params,
+                                MoveToPoseSettings settings, Pose start, const DrivetrainModel& model) {
+    SimulatedEnvironment env(start, settings.period, timeout, model);
+    moveToPose(env, target, params, settings);
+    return env.finish();
 }
 } // namespace lemlib
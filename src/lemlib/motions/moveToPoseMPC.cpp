@@ -0,0 +1,128 @@
+#include "lemlib/motions/moveToPoseMPC.hpp"
+#include "LemLog/logger/Helper.hpp"
+#include "lemlib/MotionEnvironment.hpp"
+#include "lemlib/util.hpp"
+#include "pros/rtos.hpp"
+#include <algorithm>
+
+using namespace units;
+
+namespace lemlib {
+
+static logger::Helper logHelper("lemlib/motions/moveToPoseMPC");
+
+/**
+ * @brief Move the robot to a pose with model predictive control
+ *
+ * @param env the environment to run the motion in, either the robot or a simulation
+ * @param target the pose to move to
+ * @param params the parameters of the motion
+ * @param settings the settings of the motion
+ */
+template <typename Environment>
+static void moveToPoseMPC(Environment& env, Pose target, const MoveToPoseMPCParams& params,
+                          MoveToPoseMPCSettings& settings) {
+    // reset controller state in place
+    settings.controller.reset();
+    settings.lateralExitConditions.reset();
+    settings.angularExitConditions.reset();
+
+    const MPCConstraints& constraints = settings.controller.getConstraints();
+    UnicycleOutput command = {0_inps, 0_radps};
+    ProgressTracker progress(env.getPose());
+    ActionRunner actions(params.actions);
+    // solve time statistics
+    std::uint64_t totalSolveTime = 0;
+    std::uint64_t worstSolveTime = 0;
+    int solves = 0;
+
+    while (env.wait() && !env.isDone()) {
+        const Pose pose = env.getPose();
+        const Length distance = pose.distanceTo(target);
+        const Angle angularError = angleError(target.orientation, pose.orientation);
+
+        // run actions
+        progress.update(pose, env.getDelta());
+        env.updateActions(actions, progress.getLinearProgress(distance, distance, angularError));
+
+        // check exit conditions
+        if (settings.lateralExitConditions.update(distance, env.getTime()) &&
+            settings.angularExitConditions.update(angularError, env.getTime())) {
+            break;
+        }
+
+        // plan, and measure how long it took
+        const std::uint64_t solveStart = pros::micros();
+        const MPCSolution solution = settings.controller.solve(pose, target, command);
+        const std::uint64_t solveTime = pros::micros() - solveStart;
+        totalSolveTime += solveTime;
+        worstSolveTime = std::max(worstSolveTime, solveTime);
+        solves++;
+
+        // the plan changes velocity every step of the controller, which is longer than an iteration, so the
+        // acceleration limits are also applied every iteration
+        const LinearVelocity maxLinearChange = constraints.maxLinearAcceleration * env.getDelta();
+        const AngularVelocity maxAngularChange = constraints.maxAngularAcceleration * env.getDelta();
+        command.linear += units::clamp(solution.output.linear - command.linear, -maxLinearChange, maxLinearChange);
+        command.angular +=
+            units::clamp(solution.output.angular - command.angular, -maxAngularChange, maxAngularChange);
+
+        // velocities of each side
+        const LinearVelocity turn = from_mps(to_radps(command.angular) * to_m(settings.trackWidth) / 2);
+        const LinearVelocity leftVel = command.linear - turn;
+        const LinearVelocity rightVel = command.linear + turn;
+        Number leftPower = leftVel / settings.maxSpeed;
+        Number rightPower = rightVel / settings.maxSpeed;
+        if (settings.feedforward) {
+            leftPower = settings.feedforward->calculate(to_inps(leftVel));
+            rightPower = settings.feedforward->calculate(to_inps(rightVel));
+        }
+        // ratio the powers to respect the max power, without changing the curvature
+        const Number ratio = units::max(abs(leftPower), abs(rightPower));
+        if (ratio > 1) {
+            leftPower /= ratio;
+            rightPower /= ratio;
+        }
+
+        if (log_level <= logger::Level::DEBUG) {
+            logHelper.debug("Moving with {:.4f} left power, {:.4f} right power, {:.4f} distance, {:.4f} angular "
+                            "error, {:.2f} cost, solved in {} us",
+                            leftPower, rightPower, distance, angularError, solution.cost, solveTime);
+        }
+
+        env.getLeftMotors().move(leftPower);
+        env.getRightMotors().move(rightPower);
+    }
+
+    // stop the robot
+    env.getLeftMotors().brake();
+    env.getRightMotors().brake();
+
+    // report how long solving took, compared to the time available
+    if (solves == 0) return;
+    if (log_level <= logger::Level::INFO) {
+        logHelper.info("MPC solved {} times, mean solve time {} us, worst solve time {} us, period {}", solves,
+                       totalSolveTime / solves, worstSolveTime, settings.period);
+    }
+    if (from_usec(worstSolveTime) > settings.period) {
+        logHelper.warn("MPC solve took longer than the period of the motion! Reduce the iterations of the controller");
+    }
+}
+
+void moveToPoseMPC(Pose target, Time timeout, const MoveToPoseMPCParams& params, MoveToPoseMPCSettings& settings) {
+    RobotEnvironment env(settings.period, settings.trigger, timeout, settings.poseGetter, settings.leftMotors,
+                         settings.rightMotors);
+    moveToPoseMPC(env, target, params, settings);
+}
+
+void moveToPoseMPC(Pose target, Time timeout, const MoveToPoseMPCParams& params, MoveToPoseMPCSettings&& settings) {
+    moveToPoseMPC(target, timeout, params, settings);
+}
+
+MotionPreview previewMoveToPoseMPC(Pose target, Time timeout, const MoveToPoseMPCParams& params,
+                                   MoveToPoseMPCSettings settings, Pose start, const DrivetrainModel& model) {
+    SimulatedEnvironment env(start, settings.period, timeout, model);
+    moveToPoseMPC(env, target, params, settings);
+    return env.finish();
+}
+} // namespace lemlib
@@ -0,0 +1,127 @@
+#include "lemlib/motions/trackTrajectory.hpp"
+#include "LemLog/logger/Helper.hpp"
+#include "lemlib/MotionEnvironment.hpp"
+#include "lemlib/util.hpp"
+#include <algorithm>
+
+using namespace units;
+
+namespace lemlib {
+
+static logger::Helper logHelper("lemlib/motions/trackTrajectory");
+
+/**
+ * @brief Track a trajectory in time
+ *
+ * @param env the environment to run the motion in, either the robot or a simulation
+ * @param trajectory the trajectory to track. Must not be empty
+ * @param params the parameters of the motion
+ * @param settings the settings of the motion
+ */
+template <typename Environment>
+static void trackTrajectory(Environment& env, const Trajectory& trajectory, const TrackTrajectoryParams& params,
+                            TrackTrajectorySettings& settings) {
+    const std::span<const TrajectoryPoint> points = trajectory.getPoints();
+    // length of the trajectory from each point to the end, used to estimate progress
+    const std::vector<Length> remainingLength = [&] {
+        std::vector<Length> out(points.size(), 0_in);
+        for (int i = points.size() - 2; i >= 0; i--) {
+            out.at(i) = out.at(i + 1) + points[i].pose.distanceTo(points[i + 1].pose);
+        }
+        return out;
+    }();
+    const LinearVelocity maxSpeed = trajectory.getConstraints().maxSpeed;
+    ProgressTracker progress(env.getPose());
+    ActionRunner actions(params.actions);
+    std::optional<Time> startTime = std::nullopt;
+
+    while (env.wait() && !env.isDone()) {
+        if (!startTime) startTime = env.getTime();
+        const Time elapsed = env.getTime() - *startTime;
+        if (elapsed > trajectory.getDuration()) break;
+        const Pose pose = env.getPose();
+
+        // where the robot should be now, and how it should be moving
+        const TrajectoryPoint reference = trajectory.sample(elapsed);
+        const AngularVelocity referenceAngular = from_radps(to_mps(reference.speed) * reference.curvature.internal());
+        // acceleration of the reference, to be tracked with feedforward
+        const LinearAcceleration referenceAcceleration =
+            (trajectory.sample(elapsed + settings.period).speed - reference.speed) / settings.period;
+
+        // run actions
+        progress.update(pose, env.getDelta());
+        {
+            // the first point the robot hasn't reached yet
+            const size_t index = std::upper_bound(points.begin(), points.end() - 1, elapsed,
+                                                  [](Time time, const TrajectoryPoint& point) {
+                                                      return time < point.time;
+                                                  }) -
+                                 points.begin();
+            const Length lateralError = pose.distanceTo(reference.pose);
+            const Angle angularError = angleError(reference.pose.orientation, pose.orientation);
+            env.updateActions(actions, progress.getLinearProgress(lateralError + remainingLength.at(index),
+                                                                         lateralError, angularError));
+        }
+
+        // velocities of the robot, then of each side
+        const UnicycleOutput out =
+            settings.controller.calculate(pose, reference.pose, reference.speed, referenceAngular);
+        const LinearVelocity turn = from_mps(to_radps(out.angular) * to_m(settings.trackWidth) / 2);
+        const LinearVelocity leftVel = out.linear - turn;
+        const LinearVelocity rightVel = out.linear + turn;
+
+        Number leftPower = leftVel / maxSpeed;
+        Number rightPower = rightVel / maxSpeed;
+        if (settings.feedforward) {
+            // angular acceleration is small compared to linear acceleration, so both sides use the same acceleration
+            leftPower = settings.feedforward->calculate(to_inps(leftVel), to_inps2(referenceAcceleration));
+            rightPower = settings.feedforward->calculate(to_inps(rightVel), to_inps2(referenceAcceleration));
+        }
+
+        // ratio the powers to respect the max power, without changing the curvature
+        const Number ratio = units::max(abs(leftPower), abs(rightPower));
+        if (ratio > 1) {
+            leftPower /= ratio;
+            rightPower /= ratio;
+        }
+
+        env.getLeftMotors().move(leftPower);
+        env.getRightMotors().move(rightPower);
+    }
+
+    // stop the robot
+    env.getLeftMotors().brake();
+    env.getRightMotors().brake();
+}
+
+void trackTrajectory(const Trajectory& trajectory, Time timeout, const TrackTrajectoryParams& params,
+                     TrackTrajectorySettings& settings) {
+    if (trajectory.getPoints().empty()) {
+        logHelper.error("Trajectory is empty! Did it have at least 2 targets? Skipping motion");
+        return;
+    }
+    if (log_level <= logger::Level::INFO) {
+        logHelper.info("tracking trajectory with {} points, expected to take {}", trajectory.getPoints().size(),
+                       trajectory.getDuration());
+    }
+    RobotEnvironment env(settings.period, settings.trigger, timeout, settings.poseGetter, settings.leftMotors,
+                         settings.rightMotors);
+    trackTrajectory(env, trajectory, params, settings);
+}
+
+void trackTrajectory(const Trajectory& trajectory, Time timeout, const TrackTrajectoryParams& params,
+                     TrackTrajectorySettings&& settings) {
+    trackTrajectory(trajectory, timeout, params, settings);
+}
+
+MotionPreview previewTrackTrajectory(const Trajectory& trajectory, Time timeout, const TrackTrajectoryParams& params,
+                                     TrackTrajectorySettings settings, Pose start, const DrivetrainModel& model) {
+    SimulatedEnvironment env(start, settings.period, timeout, model);
+    if (trajectory.getPoints().empty()) {
+        logHelper.error("Trajectory is empty! Did it have at least 2 targets? Skipping preview");
+        return env.finish();
+    }
+    trackTrajectory(env, trajectory, params, settings);
+    return env.finish();
+}
+} // namespace lemlib
@@ -1,7 +1,8 @@
 #include "lemlib/motions/turnTo.hpp"
-#include "lemlib/MotionCancelHelper.hpp"
+#include "lemlib/ControlPipeline.hpp"
+#include "lemlib/MotionEnvironment.hpp"
+#include "lemlib/MotionProfile.hpp"
 #include "LemLog/logger/Helper.hpp"
-#include "lemlib/Timer.hpp"
 #include "lemlib/util.hpp"
 #include <optional>
 #include <variant>
@@ -31,16 +32,27 @@ static Angle calculateError(std::variant<Angle, V2Position> target, const Pose&
     else return pose.angleTo(std::get<V2Position>(target));
 }
 
-void turnTo(std::variant<Angle, V2Position> target, Time timeout, TurnToParams params, TurnToSettings settings) {
-    // print debug info
-    if (std::holds_alternative<Angle>(target)) logHelper.info("Turning to {:.2f}", std::get<Angle>(target));
-    else logHelper.info("Turning to face point {:.2f}", std::get<V2Position>(target));
+/**
+ * @brief Turn the robot to face a heading or position
+ *
+ * @param env the environment to run the motion in, either the robot or a simulation
+ * @param target the target to turn to
+ * @param params the parameters of the turn
+ * @param settings the settings of the turn
+ */
+template <typename Environment>
+static void turnTo(Environment& env, std::variant<Angle, V2Position> target, const TurnToParams& params,
+                   TurnToSettings& settings) {
+    // reset controller state in place
+    settings.angularPID.reset();
+    settings.ratePID.reset();
+    settings.exitConditions.reset();
 
     // figure out which way to limit acceleration
     const SlewDirection slewDirection = [&] {
         if (params.direction == AngularDirection::CCW_COUNTERCLOCKWISE) return SlewDirection::INCREASING;
         if (params.direction == AngularDirection::CW_CLOCKWISE) return SlewDirection::DECREASING;
-        const Pose pose = settings.poseGetter();
+        const Pose pose = env.getPose();
         const Angle error = calculateError(target, pose);
         if (error > 0_stDeg) return SlewDirection::INCREASING;
         else return SlewDirection::DECREASING;
@@ -48,25 +60,43 @@ void turnTo(std::variant<Angle, V2Position> target, Time timeout, TurnToParams p
     // initialize persistent variables
     std::optional<Angle> prevRawDeltaTheta = std::nullopt;
     std::optional<Angle> prevDeltaTheta = std::nullopt;
-    Timer timer(timeout);
     Angle deltaTheta = Angle(INFINITY);
     bool settling = false;
-    Number prevMotorPower = 0.0;
+    // PID, slew except when settling, and speed limits
+    auto chain = pipeline::chain(pipeline::PIDController(settings.angularPID),
+                                 pipeline::Unless(settling, pipeline::Slew(params.slew, slewDirection)),
+                                 pipeline::MinSpeed(params.maxSpeed, params.minSpeed));
+    pipeline::DriveOutput output(env.getLeftMotors(), env.getRightMotors(), pipeline::Unmixed());
+    ProgressTracker progress(env.getPose());
+    ActionRunner actions(params.actions);
+
+    // generate the profile of a profiled turn, in radians
+    const std::optional<MotionProfile> profile = [&] -> std::optional<MotionProfile> {
+        if (!params.profile) return std::nullopt;
+        const TurnProfile& limits = *params.profile;
+        const Angle distance = calculateError(target, env.getPose(), params.direction);
+        const Number jerk =
+            limits.jerkTime > 0_sec ? Number(to_radps2(limits.maxAcceleration) / to_sec(limits.jerkTime)) : Number(0);
+        return MotionProfile(to_stRad(distance), to_radps(limits.maxVelocity), to_radps2(limits.maxAcceleration),
+                             jerk);
+    }();
+    if (profile && log_level <= logger::Level::DEBUG) logHelper.debug("Profiled turn takes {}", profile->getDuration());
+    std::optional<Time> startTime = std::nullopt;
+    Angle prevOrientation = env.getPose().orientation;
 
     // save original brake modes
-    const BrakeMode leftBrakeMode = settings.leftMotors.getBrakeMode();
-    const BrakeMode rightBrakeMode = settings.rightMotors.getBrakeMode();
+    const BrakeMode leftBrakeMode = env.getLeftMotors().getBrakeMode();
+    const BrakeMode rightBrakeMode = env.getRightMotors().getBrakeMode();
     // lock one side of the drivetrain if requested
     if (params.lockedSide) {
-        if (*params.lockedSide == TurnToParams::LockedSide::LEFT) settings.leftMotors.setBrakeMode(BrakeMode::BRAKE);
-        else settings.rightMotors.setBrakeMode(BrakeMode::BRAKE);
+        if (*params.lockedSide == TurnToParams::LockedSide::LEFT) env.getLeftMotors().setBrakeMode(BrakeMode::BRAKE);
+        else env.getRightMotors().setBrakeMode(BrakeMode::BRAKE);
     }
 
-    lemlib::MotionCancelHelper helper(10_msec); // cancel helper
     // loop until the motion has been cancelled, the timer is done, or an exit condition has been met
-    while (helper.wait() && !timer.isDone() && !settings.exitConditions.update(deltaTheta)) {
+    while (env.wait() && !env.isDone() && !settings.exitConditions.update(deltaTheta, env.getTime())) {
         // get the robot's current position
-        const Pose pose = settings.poseGetter();
+        const Pose pose = env.getPose();
 
         // calculate deltaTheta
         deltaTheta = [&] {
@@ -78,6 +108,14 @@ void turnTo(std::variant<Angle, V2Position> target, Time timeout, TurnToParams p
             return error;
         }();
 
+        // run actions
+        progress.update(pose, env.getDelta());
+        env.updateActions(actions, progress.getAngularProgress(deltaTheta));
+
+        // schedule the gains by the speed of the robot, for gain schedules indexed by ScheduleVariable::EXTERNAL
+        settings.angularPID.schedule(to_radps(progress.getAngularSpeed()));
+        settings.ratePID.schedule(to_radps(progress.getAngularSpeed()));
+
         // motion chaining
         // exit the motion to immediately continue to the next one
         if (params.minSpeed != 0 && abs(deltaTheta) < params.earlyExitRange) break;
@@ -87,38 +125,86 @@ void turnTo(std::variant<Angle, V2Position> target, Time timeout, TurnToParams p
         prevDeltaTheta = deltaTheta;
 
         // calculate speed
-        const Number motorPower = [&] {
-            Number raw = settings.angularPID.update(to_stRad(deltaTheta));
-            if (!settling) raw = slew(raw, prevMotorPower, params.slew, helper.getDelta(), slewDirection);
-            return constrainPower(raw, params.maxSpeed, params.minSpeed);
+        const Number motorPower = [&] -> Number {
+            if (!profile) return chain.update(to_stRad(deltaTheta), env.getDelta());
+            if (!startTime) startTime = env.getTime();
+            const ProfileState state = profile->sample(env.getTime() - *startTime);
+            // the remaining error should match the remaining distance of the profile
+            const Number trackingError = to_stRad(deltaTheta) - (profile->sample(profile->getDuration()).position -
+                                                                 state.position);
+            const Number rate = env.getDelta() > 0_sec
+                                    ? Number(to_stRad(angleError(pose.orientation, prevOrientation)) /
+                                             to_sec(env.getDelta()))
+                                    : Number(0);
+            prevOrientation = pose.orientation;
+            // when one side is locked, the other side turns the robot around it, so its wheels have to move twice as
+            // fast as when turning in place
+            const Number swingScale = params.lockedSide ? 2 : 1;
+            const Number feedforward = [&] -> Number {
+                if (settings.angularFeedforward) {
+                    return settings.angularFeedforward->calculate(
+                        to_degps(from_radps(swingScale * state.velocity)),
+                        to_degps2(from_radps2(swingScale * state.acceleration)));
+                }
+                // the speed of the wheels, as a fraction of their top speed, plus the power needed to accelerate them
+                // according to the first order drivetrain model
+                const Number velocity = state.velocity + state.acceleration * to_sec(settings.timeConstant);
+                return swingScale * velocity * to_in(settings.trackWidth) / 2 / to_inps(settings.maxSpeed);
+            }();
+            const Number out = feedforward + settings.ratePID.update(state.velocity - rate, env.getDelta()) +
+                               settings.angularPID.update(trackingError, env.getDelta());
+            return constrainPower(out, params.maxSpeed, params.minSpeed);
         }();
 
-        // record previous motor power
-        prevMotorPower = motorPower;
-
         // print debug info
-        logHelper.debug("Turning with {:.4f} power, error: {:.2f} stDeg, dt: {:.4f}", motorPower, to_stDeg(deltaTheta),
-                        helper.getDelta());
+        if (log_level <= logger::Level::DEBUG) {
+            logHelper.debug("Turning with {:.4f} power, error: {:.2f} stDeg, dt: {:.4f}", motorPower,
+                            to_stDeg(deltaTheta), env.getDelta());
+        }
 
         // move the motors
-        settings.leftMotors.move(-motorPower);
-        settings.rightMotors.move(motorPower);
+        output(0, motorPower);
         // check which side of the drivetrain to lock, if any
         if (params.lockedSide) {
             if (*params.lockedSide == TurnToParams::LockedSide::LEFT) {
-                settings.leftMotors.brake();
+                env.getLeftMotors().brake();
             } else {
-                settings.rightMotors.brake();
+                env.getRightMotors().brake();
             }
         }
     }
 
     // apply original brake modes
-    settings.leftMotors.setBrakeMode(leftBrakeMode);
-    settings.rightMotors.setBrakeMode(rightBrakeMode);
+    env.getLeftMotors().setBrakeMode(leftBrakeMode);
+    env.getRightMotors().setBrakeMode(rightBrakeMode);
 
     // stop the drivetrain
-    settings.leftMotors.brake();
-    settings.rightMotors.brake();
+    env.getLeftMotors().brake();
+    env.getRightMotors().brake();
+}
+
+void turnTo(std::variant<Angle, V2Position> target, Time timeout, const TurnToParams& params,
+            TurnToSettings& settings) {
+    // print debug info
+    if (log_level <= logger::Level::DEBUG) {
+        if (std::holds_alternative<Angle>(target)) logHelper.debug("Turning to {:.2f}", std::get<Angle>(target));
+        else logHelper.debug("Turning to face point {:.2f}", std::get<V2Position>(target));
+    }
+
+    RobotEnvironment env(settings.period, settings.trigger, timeout, settings.poseGetter, settings.leftMotors,
+                         settings.rightMotors);
+    turnTo(env, target, params, settings);
+}
+
+void turnTo(std::variant<Angle, V2Position> target, Time timeout, const TurnToParams& params,
+            TurnToSettings&& settings) {
+    turnTo(target, timeout, params, settings);
+}
+
+MotionPreview previewTurnTo(std::variant<Angle, V2Position> target, Time timeout, const TurnToParams& params,
+                            TurnToSettings settings, Pose start, const DrivetrainModel& model) {
+    SimulatedEnvironment env(start, settings.period, timeout, model);
+    turnTo(env, target, params, settings);
+    return env.finish();
 }
 } // namespace lemlib
\ No newline at end of file
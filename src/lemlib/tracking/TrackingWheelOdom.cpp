@@ -72,16 +72,40 @@ void TrackingWheelOdometry::setPose(units::Pose pose) {
     m_pose = pose;
 }
 
+Event& TrackingWheelOdometry::getPoseEvent() { return m_poseEvent; }
+
 void TrackingWheelOdometry::startTask(Time period) {
     // check if the task has been started yet
-    if (m_task == std::nullopt) { // start the task
-        m_task = pros::Task([this, period] { this->update(period); });
+    if (!m_started) { // start the task
+        m_started = true;
+        m_task = pros::Task([this, period] { this->loop(period); });
         helper.log(logger::Level::INFO, "Tracking task started!");
     } else {
         helper.log(logger::Level::WARN, "Tried to start tracking task, but it has already been started!");
     }
 }
 
+void TrackingWheelOdometry::startTask(Scheduler& scheduler, Time period) {
+    // check if the tracking has been started yet
+    if (!m_started) { // add the job
+        m_started = true;
+        m_scheduler = &scheduler;
+        m_jobId = scheduler.addJob(
+            [this] {
+                // stop updating if there are not enough sensors
+                if (m_failed) return;
+                if (!this->update()) {
+                    m_failed = true;
+                    helper.log(logger::Level::INFO, "Tracking job stopped!");
+                }
+            },
+            period);
+        helper.log(logger::Level::INFO, "Tracking job added to scheduler!");
+    } else {
+        helper.log(logger::Level::WARN, "Tried to start tracking, but it has already been started!");
+    }
+}
+
 /**
  * @brief struct representing data from a tracking wheel
  *
@@ -178,7 +202,40 @@ static std::optional<Angle> calculateIMUHeading(std::vector<IMU*>& imus) {
  * the document written by 5225A (Pilons)
  * http://thepilons.ca/wp-content/uploads/2018/10/Tracking.pdf
  */
-void TrackingWheelOdometry::update(Time period) {
+bool TrackingWheelOdometry::update() {
+    // step 1: get tracking wheel deltas
+    const TrackingWheelData horizontalData = findLateralDelta(m_horizontalWheels);
+    const TrackingWheelData verticalData = findLateralDelta(m_verticalWheels);
+
+    // step 2: calculate heading
+    const std::optional<Angle> thetaOpt = calculateIMUHeading(m_Imus)
+                                              .or_else(std::bind(&calculateWheelHeading, m_horizontalWheels))
+                                              .or_else(std::bind(&calculateWheelHeading, m_verticalWheels));
+    if (thetaOpt == std::nullopt) { // error checking
+        helper.log(logger::Level::ERROR, "Not enough sensors available!");
+        return false;
+    }
+    const Angle theta = m_offset + *thetaOpt;
+
+    // step 3: calculate change in local coordinates
+    const Angle deltaTheta = theta - m_pose.orientation;
+    const units::V2Position localPosition = [&] {
+        const units::V2Position lateralDeltas = {verticalData.distance, horizontalData.distance};
+        const units::V2Position lateralOffsets = {verticalData.offset, horizontalData.offset};
+        if (deltaTheta == 0_stRad) return lateralDeltas; // prevent divide by 0
+        return 2 * units::sin(deltaTheta / 2) * (lateralDeltas / to_stRad(deltaTheta) + lateralOffsets);
+    }();
+
+    // step 4: set global position
+    m_pose += localPosition.rotatedBy(m_pose.orientation + deltaTheta / 2);
+    m_pose.orientation = theta;
+
+    // step 5: let subscribers know there is a new pose
+    m_poseEvent.publish();
+    return true;
+}
+
+void TrackingWheelOdometry::loop(Time period) {
     // record the previous time, used for consistent loop timings
     Time prevTime = from_msec(pros::millis());
     // run until the task has been notified, which will probably never happen
@@ -186,32 +243,7 @@ void TrackingWheelOdometry::update(Time period) {
         const Time now = from_msec(pros::millis());
         const Time deltaTime = now - prevTime;
 
-        // step 1: get tracking wheel deltas
-        const TrackingWheelData horizontalData = findLateralDelta(m_horizontalWheels);
-        const TrackingWheelData verticalData = findLateralDelta(m_verticalWheels);
-
-        // step 2: calculate heading
-        const std::optional<Angle> thetaOpt = calculateIMUHeading(m_Imus)
-                                                  .or_else(std::bind(&calculateWheelHeading, m_horizontalWheels))
-                                                  .or_else(std::bind(&calculateWheelHeading, m_verticalWheels));
-        if (thetaOpt == std::nullopt) { // error checking
-            helper.log(logger::Level::ERROR, "Not enough sensors available!");
-            break;
-        }
-        const Angle theta = m_offset + *thetaOpt;
-
-        // step 3: calculate change in local coordinates
-        const Angle deltaTheta = theta - m_pose.orientation;
-        const units::V2Position localPosition = [&] {
-            const units::V2Position lateralDeltas = {verticalData.distance, horizontalData.distance};
-            const units::V2Position lateralOffsets = {verticalData.offset, horizontalData.offset};
-            if (deltaTheta == 0_stRad) return lateralDeltas; // prevent divide by 0
-            return 2 * units::sin(deltaTheta / 2) * (lateralDeltas / to_stRad(deltaTheta) + lateralOffsets);
-        }();
-
-        // step 4: set global position
-        m_pose += localPosition.rotatedBy(m_pose.orientation + deltaTheta / 2);
-        m_pose.orientation = theta;
+        if (!this->update()) break;
 
         // if current time - previous time > timeout
         // then set previous time to current time
@@ -226,5 +258,9 @@ void TrackingWheelOdometry::update(Time period) {
     helper.log(logger::Level::INFO, "Tracking task stopped!");
 }
 
-TrackingWheelOdometry::~TrackingWheelOdometry() { m_task->notify(); }
+TrackingWheelOdometry::~TrackingWheelOdometry() {
+    if (m_task) m_task->notify();
+    // the job refers to this object, so it must not run once it has been destroyed
+    if (m_scheduler && m_jobId) m_scheduler->removeJob(*m_jobId);
+}
 }; // namespace lemlib
\ No newline at end of file
@@ -31,6 +31,52 @@ Number slew(Number target, Number current, Number maxChangeRate, Time deltaTime,
     return target;
 }
 
+SCurveSlew::SCurveSlew(Number maxRate, Number maxJerk, SlewDirection restrictDirection)
+    : m_maxRate(maxRate),
+      m_maxJerk(maxJerk),
+      m_direction(restrictDirection) {}
+
+Number SCurveSlew::update(Number target, Number current, Time deltaTime) {
+    const Number change = target - current;
+    const bool unrestricted = (m_direction == SlewDirection::INCREASING && change < 0) ||
+                              (m_direction == SlewDirection::DECREASING && change > 0);
+    // without a jerk limit, this is a first order limiter
+    if (m_maxRate == 0 || m_maxJerk == 0 || unrestricted || deltaTime <= 0_sec) {
+        const Number out = slew(target, current, m_maxRate, deltaTime, m_direction);
+        // a jump which wasn't rate limited is not a rate the jerk limit should ramp down from later
+        const bool limited = m_maxRate != 0 && !unrestricted && deltaTime > 0_sec;
+        m_rate = limited ? std::clamp(Number((out - current) / to_sec(deltaTime)), -abs(m_maxRate), abs(m_maxRate))
+                         : Number(0);
+        return out;
+    }
+
+    // the fastest rate which can still be ramped down to 0 before reaching the target, when the rate only changes
+    // once per update
+    const Number maxRate = abs(m_maxRate);
+    const Number maxJerk = abs(m_maxJerk);
+    const Number maxRateChange = maxJerk * to_sec(deltaTime);
+    const Number stoppingRate = sqrt(square(maxRateChange / 2) + 2 * maxJerk * abs(change)) - maxRateChange / 2;
+    const Number desiredRate = sgn(change) * units::min(maxRate, stoppingRate);
+    m_rate = std::clamp(m_rate + std::clamp(desiredRate - m_rate, -maxRateChange, maxRateChange), -maxRate, maxRate);
+
+    const Number out = current + m_rate * to_sec(deltaTime);
+    // stop at the target instead of overshooting it
+    if ((target - out) * change <= 0) {
+        m_rate = 0;
+        return target;
+    }
+    return out;
+}
+
+void SCurveSlew::setLimits(Number maxRate, Number maxJerk) {
+    m_maxRate = maxRate;
+    m_maxJerk = maxJerk;
+}
+
+Number SCurveSlew::getRate() const { return m_rate; }
+
+void SCurveSlew::reset() { m_rate = 0; }
+
 Number constrainPower(Number power, Number max, Number min) {
     // respect minimum speed
     if (abs(power) < min) power = sgn(power) * min;
@@ -7,6 +7,8 @@
 #include "pros/llemu.hpp"
 
 logger::Terminal terminal;
+// format and log the debug messages of motions too
+extern const logger::Level log_level = logger::Level::DEBUG;
 
 lemlib::MotorGroup rightDrive({8, 10}, 360_rpm);
 lemlib::MotorGroup leftDrive({-1, 11, -12, 13}, 360_rpm);
@@ -42,7 +44,7 @@ void initialize() {
                    {
                        .angularPID = pid,
                        .exitConditions = std::vector<lemlib::ExitCondition<AngleRange>>({exitCondition}),
-                       .poseGetter = [] -> units::Pose { return odom.getPose(); },
+                       .poseGetter = odom,
                        .leftMotors = leftDrive,
                        .rightMotors = rightDrive,
                    });
@@ -0,0 +1,96 @@
+// Checks that calling a motion doesn't allocate memory
+//
+// This test runs on your computer, not on the robot. Build and run it from the root of the repository with a C++20
+// compiler that supports std::format:
+//   SOURCES="config Feedforward LQR MotionActions MotionCancelHelper MotionEnvironment MotionProfile PID Simulation"
+//   SOURCES="$SOURCES StallDetector Timer util VoltageCompensation motions/moveToPoint motions/moveToPose"
+//   SOURCES="$SOURCES motions/turnTo"
+//   FILES="tests/motionAllocations.cpp tests/stubs.cpp $(printf 'src/lemlib/%s.cpp ' $SOURCES)"
+//   g++ -std=c++20 -Iinclude $FILES -o motion-allocations
+//   ./motion-allocations
+//
+// Each motion is called like on the robot, through the entry point which takes its settings by reference, with the
+// default log level. It runs in a RobotEnvironment against the stand-ins in tests/stubs.cpp until it times out. Every
+// allocation from the call to the return counts, so the test fails if calling a motion allocates at all.
+
+#include "lemlib/motions/moveToPoint.hpp"
+#include "lemlib/motions/moveToPose.hpp"
+#include "lemlib/motions/turnTo.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+using namespace units;
+
+/** how many times a motor group has been commanded, counted by the stubs */
+extern std::uint64_t stubMoves;
+
+/** how many times memory has been allocated */
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+/** the pose the odometry reports. The stubbed motors don't move the robot, so it only changes between motions */
+static units::Pose robotPose(0_in, 0_in, 90_stDeg);
+
+// the configuration of the robot, like in a user project. The log level keeps its default
+lemlib::MotorGroup left_motors({-1, 2, -3}, 450_rpm);
+lemlib::MotorGroup right_motors({4, -5, 6}, 450_rpm);
+const lemlib::PID angular_pid(2, 0, 0.1);
+const lemlib::PID lateral_pid(10, 0, 3);
+const std::function<units::Pose()> pose_getter = [] { return robotPose; };
+const lemlib::ExitConditionGroup<AngleRange> angular_exit_conditions({{1_stDeg, 100_msec}, {3_stDeg, 500_msec}});
+const lemlib::ExitConditionGroup<Length> lateral_exit_conditions({{1_in, 100_msec}, {3_in, 500_msec}});
+const Length track_width = 12_in;
+const Number drift_compensation = 2;
+const Number angular_slew = 0;
+const Number lateral_slew = 0;
+
+/**
+ * @brief Count the allocations made by calling a motion
+ *
+ * @param name the name of the motion, which is printed
+ * @param motion function which calls the motion
+ *
+ * @return true the motion didn't allocate
+ * @return false the motion allocated
+ */
+template <typename Motion> static bool check(const char* name, Motion motion) {
+    const std::uint64_t movesBefore = stubMoves;
+    const std::size_t before = allocations;
+    motion();
+    const std::size_t motionAllocations = allocations - before;
+    // each iteration commands both sides of the drivetrain
+    const std::uint64_t iterations = (stubMoves - movesBefore) / 2;
+    std::cout << name << ": " << motionAllocations << " allocations in " << iterations << " iterations" << std::endl;
+    return motionAllocations == 0 && iterations > 1;
+}
+
+int main() {
+    // created up front, like settings reused by an autonomous routine
+    const lemlib::MoveToPointParams pointParams;
+    lemlib::MoveToPointSettings pointSettings;
+    const lemlib::MoveToPoseParams poseParams;
+    lemlib::MoveToPoseSettings poseSettings;
+    const lemlib::TurnToParams turnParams;
+    const lemlib::TurnToParams profiledTurnParams {.profile = lemlib::TurnProfile {.jerkTime = 50_msec}};
+    lemlib::TurnToSettings turnSettings;
+    const std::variant<Angle, V2Position> turnTarget = 90_cDeg;
+
+    bool passed = true;
+    passed &= check("moveToPoint", [&] { lemlib::moveToPoint({0_in, 48_in}, 1_sec, pointParams, pointSettings); });
+    passed &= check("moveToPose",
+                    [&] { lemlib::moveToPose({0_in, 48_in, 0_cDeg}, 1_sec, poseParams, poseSettings); });
+    passed &= check("turnTo", [&] { lemlib::turnTo(turnTarget, 1_sec, turnParams, turnSettings); });
+    passed &= check("profiled turnTo", [&] { lemlib::turnTo(turnTarget, 1_sec, profiledTurnParams, turnSettings); });
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+// Checks that a RobotEnvironment keeps reading the right pose, whatever its PoseSource was created from
+//
+// This test runs on your computer, not on the robot. Build and run it from the root of the repository with a C++20
+// compiler that supports std::format:
+//   SOURCES="config LQR MotionActions MotionCancelHelper MotionEnvironment Timer util VoltageCompensation"
+//   FILES="tests/robotEnvironment.cpp tests/stubs.cpp $(printf 'src/lemlib/%s.cpp ' $SOURCES)"
+//   g++ -std=c++20 -Iinclude $FILES -o robot-environment
+//   ./robot-environment
+//
+// The environment is built from a temporary PoseSource, which is destroyed before the pose is read. The stack is
+// overwritten in between, so an environment which refers to the temporary instead of copying it reads garbage.
+
+#include "lemlib/MotionEnvironment.hpp"
+#include <cstring>
+#include <iostream>
+#include <optional>
+
+using namespace units;
+
+/** stands in for the odometry */
+struct Odometry {
+        units::Pose pose;
+
+        units::Pose getPose() { return pose; }
+};
+
+/**
+ * @brief Overwrite the part of the stack a temporary would have been stored in
+ */
+[[gnu::noinline]] static void clobberStack() {
+    volatile unsigned char buffer[4096];
+    std::memset(const_cast<unsigned char*>(buffer), 0xAB, sizeof(buffer));
+}
+
+/**
+ * @brief Check that an environment reads the pose it should
+ *
+ * @param name the name of the check, which is printed
+ * @param env the environment
+ * @param expected the pose it should read
+ *
+ * @return true the environment read the expected pose
+ * @return false the environment read something else
+ */
+static bool check(const char* name, lemlib::RobotEnvironment& env, units::Pose expected) {
+    clobberStack();
+    const units::Pose pose = env.getPose();
+    const bool passed = pose.x == expected.x && pose.y == expected.y && pose.orientation == expected.orientation;
+    std::cout << name << ": read x = " << to_in(pose.x) << " in, expected " << to_in(expected.x) << " in"
+              << std::endl;
+    return passed;
+}
+
+lemlib::MotorGroup leftMotors({1}, 450_rpm);
+lemlib::MotorGroup rightMotors({2}, 450_rpm);
+Odometry odom {{1_in, 2_in, 3_stRad}};
+
+units::Pose getPose() { return {4_in, 5_in, 6_stRad}; }
+
+int main() {
+    bool passed = true;
+    {
+        // a temporary referring to an object with a getPose() member function
+        lemlib::RobotEnvironment env(10_msec, nullptr, 1_sec, lemlib::PoseSource(odom), leftMotors, rightMotors);
+        passed &= check("temporary from a pose provider", env, odom.pose);
+    }
+    {
+        // a temporary referring to a function
+        lemlib::RobotEnvironment env(10_msec, nullptr, 1_sec, lemlib::PoseSource(getPose), leftMotors, rightMotors);
+        passed &= check("temporary from a function", env, getPose());
+    }
+    {
+        // a copy of a PoseSource which is destroyed before the pose is read
+        std::optional<lemlib::PoseSource> source = lemlib::PoseSource(odom);
+        lemlib::PoseSource copy = *source;
+        source.reset();
+        lemlib::RobotEnvironment env(10_msec, nullptr, 1_sec, copy, leftMotors, rightMotors);
+        passed &= check("copy of a destroyed PoseSource", env, odom.pose);
+    }
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
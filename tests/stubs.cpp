@@ -0,0 +1,93 @@
+// Stand-ins for the parts of PROS and LemLog that the tests link against, but never call on the robot's behalf
+//
+// Motions run against these stand-ins when a test calls them like on the robot. The clock is a counter, which moves
+// forward whenever a task would sleep, so motions run through their timeout without waiting in real time. The motors
+// don't move anything, they only count how many times they have been commanded.
+
+#include "hardware/Motor/MotorGroup.hpp"
+#include "LemLog/logger/Helper.hpp"
+#include "lemlib/Event.hpp"
+#include "lemlib/MotionHandler.hpp"
+#include "pros/misc.h"
+#include "pros/rtos.hpp"
+#include <algorithm>
+#include <cstdint>
+
+/** the time reported by the clock, in microseconds. Tests can advance it */
+std::uint64_t stubMicros = 0;
+/** how many times a motor group has been commanded */
+std::uint64_t stubMoves = 0;
+
+extern "C" {
+std::uint64_t micros() { return stubMicros; }
+
+std::uint32_t millis() { return stubMicros / 1000; }
+
+void delay(std::uint32_t milliseconds) { stubMicros += std::uint64_t(milliseconds) * 1000; }
+
+std::uint8_t competition_get_status() { return 0; }
+
+std::int32_t battery_get_voltage() { return 12000; }
+}
+
+namespace pros::rtos {
+void Task::delay_until(std::uint32_t* const prevTime, const std::uint32_t delta) {
+    *prevTime += delta;
+    stubMicros = std::max(stubMicros, std::uint64_t(*prevTime) * 1000);
+}
+
+// tasks are never notified, so waiting for a notification always times out
+std::uint32_t Task::notify_take(bool, std::uint32_t timeout) {
+    stubMicros += std::uint64_t(timeout) * 1000;
+    return 0;
+}
+
+Mutex::Mutex() {}
+
+void Mutex::lock() {}
+
+void Mutex::unlock() {}
+} // namespace pros::rtos
+
+namespace lemlib {
+MotorGroup::MotorGroup(std::initializer_list<ReversibleSmartPort>, AngularVelocity outputVelocity)
+    : m_outputVelocity(outputVelocity) {}
+
+int MotorGroup::move(Number) {
+    ++stubMoves;
+    return 0;
+}
+
+int MotorGroup::brake() { return 0; }
+
+int MotorGroup::setBrakeMode(BrakeMode mode) {
+    m_brakeMode = mode;
+    return 0;
+}
+
+BrakeMode MotorGroup::getBrakeMode() { return m_brakeMode; }
+
+int MotorGroup::isConnected() { return 1; }
+
+Angle MotorGroup::getAngle() { return 0_stRad; }
+
+int MotorGroup::setAngle(Angle) { return 0; }
+
+bool Event::subscribe() { return true; }
+
+void Event::unsubscribe() {}
+
+void Event::publish() {}
+
+Event& motion_handler::getProgressEvent() {
+    static Event event;
+    return event;
+}
+} // namespace lemlib
+
+namespace logger {
+Helper::Helper(const std::string& topic)
+    : m_topic(topic) {}
+
+void log(Level, const std::string&, const std::string&) {}
+} // namespace logger
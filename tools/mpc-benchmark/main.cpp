@@ -0,0 +1,87 @@
+// Benchmarks lemlib::PoseMPC, the solver used by lemlib::moveToPoseMPC()
+//
+// This tool runs on your computer, not on the robot. Build it from the root of the repository with any C++20 compiler:
+//   g++ -std=c++20 -O2 -Iinclude tools/mpc-benchmark/main.cpp src/lemlib/{MPC,LQR,util}.cpp -o mpc-benchmark
+//
+// Usage:
+//   mpc-benchmark [iterations] [step (ms)]
+//
+// A few pose motions are run in closed loop against a unicycle model of the robot, updating the controller every
+// 10 ms like on the robot. For each motion, the tool prints where the robot ended up and how long the solves took.
+// The V5 brain is much slower than a computer, so the solve times measured here are a lower bound: check the solve
+// times logged by moveToPoseMPC() on the robot before relying on a configuration.
+
+#include "lemlib/MPC.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using namespace units;
+
+/** how often the controller is updated on the robot */
+constexpr Time PERIOD = 10_msec;
+
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? std::stoi(argv[1]) : 40;
+    const Time step = from_msec(argc > 2 ? std::stod(argv[2]) : 50);
+    const lemlib::MPCConstraints constraints;
+
+    struct Scenario {
+            const char* name;
+            Pose start;
+            Pose target;
+    };
+
+    const Scenario scenarios[] = {
+        {"straight", {0_in, 0_in, 0_stDeg}, {0_in, 48_in, 90_stDeg}},
+        {"offset", {0_in, 0_in, 90_stDeg}, {24_in, 36_in, 90_stDeg}},
+        {"sideways", {0_in, 0_in, 90_stDeg}, {36_in, 0_in, 0_stDeg}},
+        {"behind", {0_in, 0_in, 90_stDeg}, {0_in, -24_in, 90_stDeg}},
+        {"lateral", {0_in, 0_in, 90_stDeg}, {6_in, 24_in, 90_stDeg}},
+    };
+
+    std::cout << "iterations: " << iterations << ", horizon: " << lemlib::PoseMPC::HORIZON << " steps of "
+              << to_msec(step) << " ms\n";
+    double worstOverall = 0;
+    for (const Scenario& scenario : scenarios) {
+        lemlib::PoseMPC mpc(constraints, {}, step, iterations);
+        Pose pose = scenario.start;
+        lemlib::UnicycleOutput command = {0_inps, 0_radps};
+        double totalTime = 0;
+        double worstTime = 0;
+        int solves = 0;
+        Time elapsed = 0_sec;
+        for (; elapsed < 4_sec; elapsed += PERIOD) {
+            const auto before = std::chrono::steady_clock::now();
+            const lemlib::MPCSolution solution = mpc.solve(pose, scenario.target, command);
+            const double solveTime =
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - before).count();
+            totalTime += solveTime;
+            worstTime = std::max(worstTime, solveTime);
+            solves++;
+            // limit the change in the command to the acceleration limits, like moveToPoseMPC()
+            command.linear += units::clamp(solution.output.linear - command.linear,
+                                           -constraints.maxLinearAcceleration * PERIOD,
+                                           constraints.maxLinearAcceleration * PERIOD);
+            command.angular += units::clamp(solution.output.angular - command.angular,
+                                            -constraints.maxAngularAcceleration * PERIOD,
+                                            constraints.maxAngularAcceleration * PERIOD);
+            // move the robot, assuming it tracks the command perfectly
+            const double theta = to_stRad(pose.orientation);
+            pose.x += from_m(to_mps(command.linear) * std::cos(theta) * to_sec(PERIOD));
+            pose.y += from_m(to_mps(command.linear) * std::sin(theta) * to_sec(PERIOD));
+            pose.orientation += from_stRad(to_radps(command.angular) * to_sec(PERIOD));
+            if (pose.distanceTo(scenario.target) < 0.5_in && abs(command.linear) < 1_inps) break;
+        }
+        worstOverall = std::max(worstOverall, worstTime);
+        const double headingError =
+            std::remainder(to_stDeg(pose.orientation - scenario.target.orientation), 360.0);
+        std::cout << scenario.name << ": " << to_sec(elapsed) << " s, position error "
+                  << to_in(pose.distanceTo(scenario.target)) << " in, heading error " << headingError
+                  << " deg, mean solve " << totalTime / solves << " us, worst solve " << worstTime << " us\n";
+    }
+    std::cout << "worst solve time: " << worstOverall << " us, " << worstOverall / to_usec(PERIOD) * 100
+              << "% of the loop\n";
+}
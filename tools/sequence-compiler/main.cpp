@@ -0,0 +1,98 @@
+// Compiles a sequence of targets into a path file that can be followed with lemlib::follow()
+//
+// This tool runs on your computer, not on the robot. Build it from the root of the repository with any C++20 compiler:
+//   g++ -std=c++20 -Iinclude tools/sequence-compiler/main.cpp src/lemlib/Trajectory.cpp -o compile-sequence
+//
+// Usage:
+//   compile-sequence <targets file> <path file> [max speed (in/s)] [max acceleration (in/s^2)] [track width (in)]
+//
+// The targets file has one target per line, in the format "x, y, heading, tolerance". x, y and the tolerance are in
+// inches, and the heading is in compass degrees, or "-" to let the compiler choose it. The first line is the pose of
+// the robot at the start of the sequence. Lines starting with '#' are ignored. For example:
+//   # start facing forwards
+//   0, 0, 0, 0
+//   # pass within 3 inches of this point
+//   24, 24, -, 3
+//   48, 0, 180, 0
+//
+// The path file can be added to the static folder of your project and followed like any other path:
+//   ASSET(myPath_txt);
+//   lemlib::follow(myPath_txt, 10_in, 5_sec, {}, {});
+
+#include "lemlib/Trajectory.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace units;
+
+/**
+ * @brief Parse a targets file
+ *
+ * @param input the contents of the file
+ * @param targets where to write the targets
+ * @return true the file was parsed successfully
+ * @return false the file is malformed
+ */
+static bool parseTargets(std::istream& input, std::vector<lemlib::SequenceTarget>& targets) {
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(input, line)) {
+        lineNumber++;
+        if (line.empty() || line.front() == '#') continue;
+        std::stringstream stream(line);
+        std::string x, y, heading, tolerance;
+        if (!std::getline(stream, x, ',') || !std::getline(stream, y, ',') || !std::getline(stream, heading, ',') ||
+            !std::getline(stream, tolerance)) {
+            std::cerr << "line " << lineNumber << ": expected \"x, y, heading, tolerance\"\n";
+            return false;
+        }
+        try {
+            lemlib::SequenceTarget target {{from_in(std::stod(x)), from_in(std::stod(y))}};
+            // "-" means the heading is free
+            if (heading.find_first_not_of(" -") != std::string::npos) target.heading = from_cDeg(std::stod(heading));
+            target.tolerance = from_in(std::stod(tolerance));
+            targets.push_back(target);
+        } catch (const std::exception&) {
+            std::cerr << "line " << lineNumber << ": invalid number\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3 || argc > 6) {
+        std::cerr << "usage: " << argv[0]
+                  << " <targets file> <path file> [max speed (in/s)] [max acceleration (in/s^2)] [track width (in)]\n";
+        return 1;
+    }
+
+    lemlib::SequenceConstraints constraints;
+    if (argc > 3) constraints.maxSpeed = from_inps(std::stod(argv[3]));
+    if (argc > 4) constraints.maxAcceleration = from_inps2(std::stod(argv[4]));
+    if (argc > 5) constraints.trackWidth = from_in(std::stod(argv[5]));
+
+    std::ifstream input(argv[1]);
+    if (!input) {
+        std::cerr << "could not open " << argv[1] << "\n";
+        return 1;
+    }
+    std::vector<lemlib::SequenceTarget> targets;
+    if (!parseTargets(input, targets)) return 1;
+    if (targets.size() < 2) {
+        std::cerr << "a sequence needs at least 2 targets\n";
+        return 1;
+    }
+
+    const lemlib::Trajectory trajectory = lemlib::compileSequence(targets, constraints);
+    std::ofstream output(argv[2]);
+    if (!output) {
+        std::cerr << "could not open " << argv[2] << "\n";
+        return 1;
+    }
+    output << trajectory.toPathFile();
+    std::cout << "compiled " << targets.size() << " targets into " << trajectory.getPoints().size()
+              << " points, which take " << to_sec(trajectory.getDuration()) << " seconds to drive\n";
+    return 0;
+}
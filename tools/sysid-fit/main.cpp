@@ -0,0 +1,69 @@
+// Fits feedforward gains and the track width to data logged by lemlib::runSysIdTest()
+//
+// This tool runs on your computer, not on the robot. Build it from the root of the repository with any C++20 compiler:
+//   g++ -std=c++20 -Iinclude tools/sysid-fit/main.cpp src/lemlib/SysIdFit.cpp -o sysid-fit
+//
+// Usage:
+//   sysid-fit [--turn <turn test csv>] <straight line test csv>...
+//
+// Each CSV file holds a single test, written on the robot with lemlib::toCsv(). For example:
+//   std::cout << lemlib::toCsv(lemlib::runSysIdTest(lemlib::SysIdTest::QUASISTATIC_FORWARD)) << std::endl;
+
+#include "lemlib/SysIdFit.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace units;
+
+/**
+ * @brief Read the samples of a test from a file
+ *
+ * @param path the path of the file
+ * @param samples where to write the samples
+ * @return true the file was read successfully
+ * @return false the file could not be read, or has no samples
+ */
+static bool readTest(const std::string& path, std::vector<lemlib::SysIdSample>& samples) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "could not open " << path << "\n";
+        return false;
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+    samples = lemlib::fromCsv(contents.str());
+    if (samples.empty()) {
+        std::cerr << path << " has no samples\n";
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::vector<lemlib::SysIdSample>> tests;
+    std::vector<lemlib::SysIdSample> turn;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--turn" && i + 1 < argc) {
+            if (!readTest(argv[++i], turn)) return 1;
+        } else {
+            if (!readTest(arg, tests.emplace_back())) return 1;
+        }
+    }
+    if (tests.empty()) {
+        std::cerr << "usage: " << argv[0] << " [--turn <turn test csv>] <straight line test csv>...\n";
+        return 1;
+    }
+
+    lemlib::SysIdResult result = lemlib::fitFeedforward(tests);
+    if (!turn.empty()) result.trackWidth = lemlib::fitTrackWidth(turn);
+
+    std::cout << "kS: " << result.feedforward.kS.internal() << "\n";
+    std::cout << "kV: " << result.feedforward.kV.internal() << " per in/s\n";
+    std::cout << "kA: " << result.feedforward.kA.internal() << " per in/s^2\n";
+    std::cout << "r^2: " << result.rSquared.internal() << "\n";
+    if (result.rSquared < 0.9) std::cout << "warning: the fit is poor, the data may be too noisy\n";
+    if (!turn.empty()) std::cout << "track width: " << to_in(result.trackWidth) << " in\n";
+    return 0;
+}